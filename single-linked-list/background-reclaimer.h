@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Фоновый поток, освобождающий отцепленные от списков цепочки узлов.
+// Должен пережить все списки, которые его используют
+class BackgroundReclaimer {
+ public:
+  BackgroundReclaimer() : worker_([this] { WorkerLoop(); }) {}
+
+  BackgroundReclaimer(const BackgroundReclaimer &) = delete;
+  BackgroundReclaimer &operator=(const BackgroundReclaimer &) = delete;
+
+  // Освобождает все оставшиеся цепочки и останавливает поток
+  ~BackgroundReclaimer() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    has_tasks_.notify_one();
+    worker_.join();
+  }
+
+  // Ставит задачу освобождения в очередь. Задача не должна бросать исключений
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    has_tasks_.notify_one();
+  }
+
+  // Дожидается освобождения всех поставленных в очередь цепочек
+  void Flush() {
+    std::unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+  }
+
+  [[nodiscard]] size_t GetPendingCount() const {
+    std::lock_guard lock(mutex_);
+    return tasks_.size() + (busy_ ? 1 : 0);
+  }
+
+ private:
+  void WorkerLoop() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      has_tasks_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      busy_ = true;
+      lock.unlock();
+      task();
+      lock.lock();
+      busy_ = false;
+      if (tasks_.empty()) {
+        idle_.notify_all();
+      }
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable has_tasks_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> tasks_;
+  bool busy_ = false;
+  bool stopping_ = false;
+  std::thread worker_;
+};
@@ -0,0 +1,471 @@
+// Сравнение SingleLinkedList с std::forward_list и std::vector, а также
+// передачи сообщений через MpscSingleLinkedList и список под мьютексом.
+// Сборка: g++ -O2 -std=c++17 -pthread benchmark.cpp -o benchmark
+// Запуск: ./benchmark [--min-size=10] [--max-size=1000000] [--output=bench_output.txt]
+// Размеры перебираются степенями десяти, максимальный поддерживаемый — 10^8
+
+#include "compact-single-linked-list.h"
+#include "delta-single-linked-list.h"
+#include "mpsc-single-linked-list.h"
+#include "single-linked-list.h"
+#include "small-single-linked-list.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <forward_list>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Атомарный, так как память выделяют и потоки производителей
+std::atomic<size_t> allocation_count{0};
+
+}  // namespace
+
+// Замены не встраиваются, как и настоящие функции выделения памяти. Иначе GCC
+// видит free в паре с вызовом operator new и ложно предупреждает о несоответствии
+[[gnu::noinline]] void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Не даёт компилятору выбросить вычисления, результат которых не используется
+volatile size_t benchmark_sink = 0;
+
+long GetPeakRssKb() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+template <typename T>
+T MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+  return static_cast<int>(i * 2654435761u);
+}
+
+// Строки длиннее буфера SSO, чтобы каждая выделяла память
+template <>
+std::string MakeValue<std::string>(size_t i) {
+  return "benchmark-value-" + std::to_string(i) + "-padding-padding";
+}
+
+template <typename T>
+size_t Weight(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return value.size();
+  } else {
+    return static_cast<size_t>(value);
+  }
+}
+
+template <typename T>
+std::string_view TypeName() {
+  return std::is_same_v<T, std::string> ? "string" : "int";
+}
+
+template <typename Container>
+struct ContainerOps;
+
+template <typename T>
+struct ContainerOps<SingleLinkedList<T>> {
+  static constexpr std::string_view kName = "SingleLinkedList";
+  static void PushFront(SingleLinkedList<T>& c, const T& v) { c.PushFront(v); }
+  static void Clear(SingleLinkedList<T>& c) { c.Clear(); }
+};
+
+template <typename T>
+struct ContainerOps<std::forward_list<T>> {
+  static constexpr std::string_view kName = "std::forward_list";
+  static void PushFront(std::forward_list<T>& c, const T& v) { c.push_front(v); }
+  static void Clear(std::forward_list<T>& c) { c.clear(); }
+};
+
+template <typename T>
+struct ContainerOps<CompactSingleLinkedList<T>> {
+  static constexpr std::string_view kName = "CompactSingleLinkedList";
+  static void PushFront(CompactSingleLinkedList<T>& c, const T& v) {
+    c.PushFront(v);
+  }
+  static void Clear(CompactSingleLinkedList<T>& c) { c.Clear(); }
+};
+
+template <typename T>
+struct ContainerOps<SmallSingleLinkedList<T>> {
+  static constexpr std::string_view kName = "SmallSingleLinkedList";
+  static void PushFront(SmallSingleLinkedList<T>& c, const T& v) {
+    c.PushFront(v);
+  }
+  static void Clear(SmallSingleLinkedList<T>& c) { c.Clear(); }
+};
+
+template <typename T>
+struct ContainerOps<DeltaSingleLinkedList<T>> {
+  static constexpr std::string_view kName = "DeltaSingleLinkedList";
+  static void PushFront(DeltaSingleLinkedList<T>& c, const T& v) {
+    c.PushFront(v);
+  }
+  static void Clear(DeltaSingleLinkedList<T>& c) { c.Clear(); }
+};
+
+// Для вектора вставка в начало заменена на push_back: иначе сравнение
+// вырождается в O(n^2)
+template <typename T>
+struct ContainerOps<std::vector<T>> {
+  static constexpr std::string_view kName = "std::vector";
+  static void PushFront(std::vector<T>& c, const T& v) { c.push_back(v); }
+  static void Clear(std::vector<T>& c) { c.clear(); }
+};
+
+struct Measurement {
+  double ns_per_op = 0;
+  double allocations_per_op = 0;
+};
+
+class Report {
+ public:
+  static constexpr int kNameWidth = 26;
+
+  explicit Report(std::ostream& file) : file_(file) {
+    std::ostringstream header;
+    header << std::left << std::setw(kNameWidth) << "container" << std::setw(8)
+           << "type" << std::setw(10) << "op" << std::right << std::setw(11)
+           << "size" << std::setw(12) << "ns/op" << std::setw(12)
+           << "allocs/op" << std::setw(14) << "peak_rss_kb";
+    Write(header.str());
+  }
+
+  void Flush() {
+    std::cout.flush();
+    file_.flush();
+  }
+
+  void Add(std::string_view container, std::string_view type,
+           std::string_view op, size_t size, const Measurement& m) {
+    std::ostringstream line;
+    line << std::left << std::setw(kNameWidth) << container << std::setw(8) << type
+         << std::setw(10) << op << std::right << std::setw(11) << size
+         << std::fixed << std::setprecision(2) << std::setw(12) << m.ns_per_op
+         << std::setw(12) << m.allocations_per_op << std::setw(14)
+         << GetPeakRssKb();
+    Write(line.str());
+  }
+
+ private:
+  void Write(const std::string& line) {
+    std::cout << line << std::endl;
+    file_ << line << '\n';
+  }
+
+  std::ostream& file_;
+};
+
+template <typename Func>
+Measurement Measure(size_t operations, Func&& func) {
+  const size_t allocations_before = allocation_count.load();
+  const auto start = Clock::now();
+  func();
+  const auto elapsed = Clock::now() - start;
+  const double ops = static_cast<double>(operations);
+  return {std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+          static_cast<double>(allocation_count.load() - allocations_before) / ops};
+}
+
+// Выполняет замеры run в дочернем процессе, чтобы peak_rss_kb показывал пик
+// памяти этих замеров, а не всего прогона: ru_maxrss процесса не уменьшается.
+// Дочерний процесс дописывает строки в те же потоки вывода
+template <typename Func>
+void RunIsolated(Report& report, Func&& run) {
+  report.Flush();
+  const pid_t pid = fork();
+  if (pid < 0) {
+    std::cerr << "fork failed" << std::endl;
+    std::exit(1);
+  }
+  if (pid == 0) {
+    run();
+    report.Flush();
+    std::_Exit(0);
+  }
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0) {
+    std::cerr << "Benchmark case failed" << std::endl;
+    std::exit(1);
+  }
+}
+
+// Маленькие контейнеры повторяются, чтобы каждая фаза обработала
+// не меньше kTargetElements элементов
+constexpr size_t kTargetElements = 1'000'000;
+
+template <typename Container, typename T>
+void RunCase(Report& report, size_t size) {
+  using Ops = ContainerOps<Container>;
+  const size_t repeats = std::max<size_t>(1, kTargetElements / size);
+  const size_t operations = repeats * size;
+  const auto type = TypeName<T>();
+
+  std::vector<T> values;
+  values.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    values.push_back(MakeValue<T>(i));
+  }
+
+  std::vector<Container> originals(repeats);
+  std::vector<Container> copies;
+  copies.reserve(repeats);
+
+  report.Add(Ops::kName, type, "PushFront", size, Measure(operations, [&] {
+    for (auto& container : originals) {
+      for (const auto& value : values) {
+        Ops::PushFront(container, value);
+      }
+    }
+  }));
+
+  report.Add(Ops::kName, type, "Copy", size, Measure(operations, [&] {
+    for (const auto& container : originals) {
+      copies.push_back(container);
+    }
+  }));
+
+  report.Add(Ops::kName, type, "Compare", size, Measure(operations, [&] {
+    size_t equal = 0;
+    for (size_t i = 0; i < repeats; ++i) {
+      equal += originals[i] == copies[i] ? 1 : 0;
+    }
+    benchmark_sink = equal;
+  }));
+
+  report.Add(Ops::kName, type, "Iterate", size, Measure(operations, [&] {
+    size_t sum = 0;
+    for (const auto& container : originals) {
+      for (const auto& value : container) {
+        sum += Weight(value);
+      }
+    }
+    benchmark_sink = sum;
+  }));
+
+  if constexpr (std::is_same_v<Container, SingleLinkedList<T>>) {
+    report.Add(Ops::kName, type, "ForEach", size, Measure(operations, [&] {
+      size_t sum = 0;
+      for (const auto& container : originals) {
+        container.ForEach([&sum](const T& value) { sum += Weight(value); });
+      }
+      benchmark_sink = sum;
+    }));
+  }
+
+  report.Add(Ops::kName, type, "Clear", size, Measure(operations, [&] {
+    for (auto& container : copies) {
+      Ops::Clear(container);
+    }
+  }));
+
+  // Очищенные копии с резервом заполняются заново без выделения узлов
+  if constexpr (std::is_same_v<Container, SingleLinkedList<T>>) {
+    for (auto& container : copies) {
+      container.Reserve(size);
+    }
+    report.Add(Ops::kName, type, "Refill", size, Measure(operations, [&] {
+      for (auto& container : copies) {
+        for (const auto& value : values) {
+          container.PushFront(value);
+        }
+      }
+    }));
+  }
+
+  report.Add(Ops::kName, type, "Destroy", size, Measure(operations, [&] {
+    originals.clear();
+    originals.shrink_to_fit();
+  }));
+}
+
+template <typename T>
+void RunType(Report& report, size_t min_size, size_t max_size) {
+  for (size_t size = min_size; size <= max_size; size *= 10) {
+    RunIsolated(report, [&] { RunCase<SingleLinkedList<T>, T>(report, size); });
+    RunIsolated(report, [&] { RunCase<SmallSingleLinkedList<T>, T>(report, size); });
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      RunIsolated(report,
+                  [&] { RunCase<CompactSingleLinkedList<T>, T>(report, size); });
+    }
+    if constexpr (std::is_integral_v<T>) {
+      RunIsolated(report,
+                  [&] { RunCase<DeltaSingleLinkedList<T>, T>(report, size); });
+    }
+    RunIsolated(report, [&] { RunCase<std::forward_list<T>, T>(report, size); });
+    RunIsolated(report, [&] { RunCase<std::vector<T>, T>(report, size); });
+  }
+}
+
+// Канал, которым пользовались до MpscSingleLinkedList: SingleLinkedList под
+// мьютексом, потребитель забирает всё накопленное за один захват
+template <typename T>
+class MutexGuardedList {
+ public:
+  void Push(const T& value) {
+    bool was_empty = false;
+    {
+      std::lock_guard lock(mutex_);
+      was_empty = list_.IsEmpty();
+      list_.PushBack(value);
+    }
+    if (was_empty) {
+      ready_.notify_one();
+    }
+  }
+
+  SingleLinkedList<T> WaitPopBatch(size_t /*max_count*/) {
+    SingleLinkedList<T> batch;
+    std::unique_lock lock(mutex_);
+    ready_.wait(lock, [this] { return !list_.IsEmpty(); });
+    batch.swap(list_);
+    return batch;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  SingleLinkedList<T> list_;
+};
+
+template <typename Queue>
+struct QueueName;
+
+template <typename T>
+struct QueueName<MpscSingleLinkedList<T>> {
+  static constexpr std::string_view kName = "MpscSingleLinkedList";
+};
+
+template <typename T>
+struct QueueName<MutexGuardedList<T>> {
+  static constexpr std::string_view kName = "MutexGuardedList";
+};
+
+constexpr size_t kHandoffBatch = 256;
+
+// producers потоков передают одному потребителю по messages сообщений с
+// моментом отправки. Handoff — время на сообщение, Latency — 99-й процентиль
+// задержки от отправки до получения в наносекундах
+template <typename Queue>
+void RunHandoff(Report& report, size_t producers, size_t messages) {
+  using Stamp = Clock::rep;
+  const size_t total = producers * messages;
+  Queue queue;
+  std::vector<Stamp> latencies;
+  latencies.reserve(total);
+
+  const Measurement handoff = Measure(total, [&] {
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&queue, messages] {
+        for (size_t i = 0; i < messages; ++i) {
+          queue.Push(Clock::now().time_since_epoch().count());
+        }
+      });
+    }
+    while (latencies.size() < total) {
+      const auto batch = queue.WaitPopBatch(kHandoffBatch);
+      const Stamp now = Clock::now().time_since_epoch().count();
+      for (const Stamp sent : batch) {
+        latencies.push_back(now - sent);
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+
+  const auto p99 = latencies.begin() + static_cast<std::ptrdiff_t>(total * 99 / 100);
+  std::nth_element(latencies.begin(), p99, latencies.end());
+  const auto name = QueueName<Queue>::kName;
+  const auto type = "x" + std::to_string(producers);
+  report.Add(name, type, "Handoff", total, handoff);
+  report.Add(name, type, "Latency", total,
+             {static_cast<double>(*p99), handoff.allocations_per_op});
+}
+
+bool ParseSizeFlag(std::string_view arg, std::string_view name, size_t& out) {
+  if (arg.substr(0, name.size()) != name) {
+    return false;
+  }
+  out = std::stoull(std::string(arg.substr(name.size())));
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  constexpr size_t kMaxSupportedSize = 100'000'000;
+  size_t min_size = 10;
+  size_t max_size = 1'000'000;
+  std::string output = "bench_output.txt";
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (ParseSizeFlag(arg, "--min-size=", min_size) ||
+        ParseSizeFlag(arg, "--max-size=", max_size)) {
+      continue;
+    }
+    if (arg.substr(0, 9) == "--output=") {
+      output = std::string(arg.substr(9));
+      continue;
+    }
+    std::cerr << "Unknown argument: " << arg << std::endl;
+    return 1;
+  }
+  min_size = std::max<size_t>(min_size, 1);
+  max_size = std::min(max_size, kMaxSupportedSize);
+
+  std::ofstream file(output);
+  if (!file) {
+    std::cerr << "Cannot open " << output << std::endl;
+    return 1;
+  }
+  Report report(file);
+  RunType<int>(report, min_size, max_size);
+  RunType<std::string>(report, min_size, max_size);
+
+  const size_t producers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+  const size_t messages = std::max<size_t>(1, kTargetElements / producers);
+  RunIsolated(report, [&] {
+    RunHandoff<MpscSingleLinkedList<Clock::rep>>(report, producers, messages);
+  });
+  RunIsolated(report, [&] {
+    RunHandoff<MutexGuardedList<Clock::rep>>(report, producers, messages);
+  });
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Компактный односвязный список: значения и 32-битные индексы следующих
+// элементов лежат в двух параллельных массивах, освободившиеся ячейки
+// связываются в список свободных через тот же массив индексов.
+// Рассчитан на тривиально копируемые типы. Как и у вектора, вставка сверх
+// зарезервированной ёмкости делает итераторы недействительными
+template <typename Type>
+class CompactSingleLinkedList {
+  static_assert(std::is_trivially_copyable_v<Type>,
+                "CompactSingleLinkedList stores trivially copyable types");
+
+  using Index = uint32_t;
+  static constexpr Index kNoIndex = std::numeric_limits<Index>::max();
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class CompactSingleLinkedList;
+    using ValuePointer =
+        std::conditional_t<std::is_const_v<ValueType>, const Type *, Type *>;
+
+    ValuePointer values_ = nullptr;
+    const Index *next_ = nullptr;
+    Index index_ = kNoIndex;
+
+    BasicIterator(ValuePointer values, const Index *next, Index index) noexcept
+        : values_(values), next_(next), index_(index) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    BasicIterator &operator=(const BasicIterator &rhs) = default;
+
+    BasicIterator(const BasicIterator<Type> &other) noexcept
+        : values_(other.values_), next_(other.next_), index_(other.index_) {}
+
+    // Все итераторы end() равны между собой
+    [[nodiscard]] bool operator==(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return index_ == rhs.index_ &&
+             (index_ == kNoIndex || values_ == rhs.values_);
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return index_ == rhs.index_ &&
+             (index_ == kNoIndex || values_ == rhs.values_);
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(index_ != kNoIndex);
+      index_ = next_[index_];
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(index_ != kNoIndex);
+      return values_[index_];
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(index_ != kNoIndex);
+      return values_ + index_;
+    }
+  };
+
+ public:
+  using Iterator = BasicIterator<Type>;
+  using ConstIterator = BasicIterator<const Type>;
+
+  static constexpr size_t kMaxSize = kNoIndex;
+
+  CompactSingleLinkedList() = default;
+
+  CompactSingleLinkedList(const CompactSingleLinkedList &) = default;
+  CompactSingleLinkedList &operator=(const CompactSingleLinkedList &) = default;
+
+  // Забирает массивы other, other остаётся пустым
+  CompactSingleLinkedList(CompactSingleLinkedList &&other) noexcept
+      : values_(std::move(other.values_)),
+        next_(std::move(other.next_)),
+        head_(std::exchange(other.head_, kNoIndex)),
+        free_head_(std::exchange(other.free_head_, kNoIndex)),
+        size_(std::exchange(other.size_, 0)) {
+    other.values_.clear();
+    other.next_.clear();
+  }
+
+  CompactSingleLinkedList &operator=(CompactSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  CompactSingleLinkedList(std::initializer_list<Type> values) {
+    Reserve(values.size());
+    for (auto it = std::rbegin(values); it != std::rend(values); ++it) {
+      PushFront(*it);
+    }
+  }
+
+  // Обменивает содержимое списков за время O(1)
+  void swap(CompactSingleLinkedList &other) noexcept {
+    values_.swap(other.values_);
+    next_.swap(other.next_);
+    std::swap(head_, other.head_);
+    std::swap(free_head_, other.free_head_);
+    std::swap(size_, other.size_);
+  }
+
+  [[nodiscard]] Iterator begin() noexcept {
+    return Iterator(values_.data(), next_.data(), head_);
+  }
+
+  [[nodiscard]] Iterator end() noexcept {
+    return Iterator(values_.data(), next_.data(), kNoIndex);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(values_.data(), next_.data(), head_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(values_.data(), next_.data(), kNoIndex);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  // Число ячеек, которые можно занять без перераспределения массивов
+  [[nodiscard]] size_t GetCapacity() const noexcept {
+    return std::min(values_.capacity(), next_.capacity());
+  }
+
+  void Reserve(size_t capacity) {
+    if (capacity > kMaxSize) {
+      throw std::length_error("CompactSingleLinkedList capacity exceeds 2^32 - 1");
+    }
+    values_.reserve(capacity);
+    next_.reserve(capacity);
+  }
+
+  void PushFront(const Type &value) {
+    Index index = free_head_;
+    if (index != kNoIndex) {
+      free_head_ = next_[index];
+      values_[index] = value;
+    } else {
+      if (values_.size() == kMaxSize) {
+        throw std::length_error("CompactSingleLinkedList size exceeds 2^32 - 1");
+      }
+      index = static_cast<Index>(values_.size());
+      values_.push_back(value);
+      try {
+        next_.push_back(kNoIndex);
+      } catch (...) {
+        values_.pop_back();
+        throw;
+      }
+    }
+    next_[index] = head_;
+    head_ = index;
+    ++size_;
+  }
+
+  // Удаляет первый элемент, его ячейка попадает в список свободных
+  void PopFront() noexcept {
+    assert(!IsEmpty());
+    const Index index = head_;
+    head_ = next_[index];
+    next_[index] = free_head_;
+    free_head_ = index;
+    --size_;
+  }
+
+  // Ёмкость массивов сохраняется для повторного заполнения
+  void Clear() noexcept {
+    values_.clear();
+    next_.clear();
+    head_ = kNoIndex;
+    free_head_ = kNoIndex;
+    size_ = 0;
+  }
+
+ private:
+  std::vector<Type> values_;
+  std::vector<Index> next_;
+  Index head_ = kNoIndex;
+  Index free_head_ = kNoIndex;
+  size_t size_ = 0;
+};
+
+template <typename Type>
+void swap(CompactSingleLinkedList<Type> &lhs,
+          CompactSingleLinkedList<Type> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename Type>
+bool operator==(const CompactSingleLinkedList<Type> &lhs,
+                const CompactSingleLinkedList<Type> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type>
+bool operator!=(const CompactSingleLinkedList<Type> &lhs,
+                const CompactSingleLinkedList<Type> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const CompactSingleLinkedList<Type> &lhs,
+               const CompactSingleLinkedList<Type> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type>
+bool operator<=(const CompactSingleLinkedList<Type> &lhs,
+                const CompactSingleLinkedList<Type> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const CompactSingleLinkedList<Type> &lhs,
+               const CompactSingleLinkedList<Type> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const CompactSingleLinkedList<Type> &lhs,
+                const CompactSingleLinkedList<Type> &rhs) {
+  return !(lhs < rhs);
+}
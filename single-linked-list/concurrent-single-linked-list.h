@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "single-linked-list.h"
+
+// Lock-free стек Трайбера: вставка и извлечение из начала через CAS на голове
+// списка. Узлы освобождаются только после того, как на них не ссылается ни один
+// hazard pointer, поэтому адрес узла не может быть переиспользован во время
+// чужого CAS (защита от ABA) и чтение next_node_ не обращается к освобождённой памяти
+template <typename Type>
+class ConcurrentSingleLinkedList {
+  struct Node {
+    Type value_;
+    Node *next_node_ = nullptr;
+    // Связь в списке узлов, ожидающих освобождения
+    Node *retired_next_ = nullptr;
+
+    template <typename... Args>
+    explicit Node(Args &&...args) : value_(std::forward<Args>(args)...) {}
+  };
+
+  struct alignas(64) HazardSlot {
+    std::atomic<bool> owned_{false};
+    std::atomic<Node *> pointer_{nullptr};
+  };
+
+  // Слот hazard pointer, занятый на время одной операции
+  class HazardGuard {
+   public:
+    explicit HazardGuard(ConcurrentSingleLinkedList &list) noexcept
+        : slot_(list.AcquireSlot()) {}
+
+    HazardGuard(const HazardGuard &) = delete;
+    HazardGuard &operator=(const HazardGuard &) = delete;
+
+    ~HazardGuard() {
+      slot_.pointer_.store(nullptr, std::memory_order_release);
+      slot_.owned_.store(false, std::memory_order_release);
+    }
+
+    void Protect(Node *node) noexcept { slot_.pointer_.store(node); }
+
+    void Reset() noexcept {
+      slot_.pointer_.store(nullptr, std::memory_order_release);
+    }
+
+   private:
+    HazardSlot &slot_;
+  };
+
+  // Итератор по цепочке узлов для построения SingleLinkedList в PopAll
+  class ChainIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Type *;
+    using reference = Type &;
+
+    ChainIterator() = default;
+    explicit ChainIterator(Node *node) noexcept : node_(node) {}
+
+    [[nodiscard]] bool operator==(const ChainIterator &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+    [[nodiscard]] bool operator!=(const ChainIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+    ChainIterator &operator++() noexcept {
+      node_ = node_->next_node_;
+      return *this;
+    }
+    ChainIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+    [[nodiscard]] reference operator*() const noexcept { return node_->value_; }
+    [[nodiscard]] pointer operator->() const noexcept { return &node_->value_; }
+
+   private:
+    Node *node_ = nullptr;
+  };
+
+ public:
+  static constexpr size_t kMaxHazardSlots = 128;
+
+  ConcurrentSingleLinkedList() = default;
+
+  ConcurrentSingleLinkedList(const ConcurrentSingleLinkedList &) = delete;
+  ConcurrentSingleLinkedList &operator=(const ConcurrentSingleLinkedList &) =
+      delete;
+
+  // Вызывается, когда с объектом уже не работает ни один поток
+  ~ConcurrentSingleLinkedList() {
+    DeleteChain(head_.load(std::memory_order_acquire),
+                [](Node *node) { return node->next_node_; });
+    DeleteChain(retired_.load(std::memory_order_acquire),
+                [](Node *node) { return node->retired_next_; });
+  }
+
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  template <typename... Args>
+  void EmplaceFront(Args &&...args) {
+    Node *node = new Node(std::forward<Args>(args)...);
+    // Размер увеличивается до публикации узла: извлечение, увидевшее узел,
+    // уменьшает уже увеличенный счётчик, и GetSize не уходит ниже нуля
+    size_.fetch_add(1, std::memory_order_relaxed);
+    node->next_node_ = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next_node_, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  // Извлекает элемент из начала или возвращает nullopt, если стек пуст
+  [[nodiscard]] std::optional<Type> TryPopFront() {
+    Node *node = nullptr;
+    {
+      HazardGuard guard(*this);
+      node = head_.load(std::memory_order_acquire);
+      while (node != nullptr) {
+        guard.Protect(node);
+        Node *current = head_.load();
+        if (current != node) {
+          node = current;
+          continue;
+        }
+        if (head_.compare_exchange_strong(node, node->next_node_)) {
+          break;
+        }
+      }
+    }
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    try {
+      std::optional<Type> result(std::move(node->value_));
+      Retire(node, node, 1);
+      return result;
+    } catch (...) {
+      Retire(node, node, 1);
+      throw;
+    }
+  }
+
+  // Атомарно забирает все элементы. Порядок результата — от вершины стека к дну
+  [[nodiscard]] SingleLinkedList<Type> PopAll() {
+    Node *chain = head_.exchange(nullptr);
+    if (chain == nullptr) {
+      return {};
+    }
+    size_t count = 0;
+    Node *last = chain;
+    for (Node *node = chain; node != nullptr; node = node->next_node_) {
+      node->retired_next_ = node->next_node_;
+      last = node;
+      ++count;
+    }
+    size_.fetch_sub(count, std::memory_order_relaxed);
+    try {
+      SingleLinkedList<Type> result(
+          std::make_move_iterator(ChainIterator(chain)),
+          std::make_move_iterator(ChainIterator()));
+      Retire(chain, last, count);
+      return result;
+    } catch (...) {
+      Retire(chain, last, count);
+      throw;
+    }
+  }
+
+  // Приблизительный размер: при одновременных изменениях может устареть
+  [[nodiscard]] size_t GetSize() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool IsEmpty() const noexcept {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  // Порог числа ожидающих узлов, после которого выполняется сканирование
+  static constexpr size_t kScanThreshold = 2 * kMaxHazardSlots;
+
+  HazardSlot &AcquireSlot() noexcept {
+    static thread_local const size_t hint =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (size_t attempt = 0;; ++attempt) {
+      HazardSlot &slot = hazards_[(hint + attempt) % kMaxHazardSlots];
+      if (!slot.owned_.load(std::memory_order_relaxed) &&
+          !slot.owned_.exchange(true, std::memory_order_acquire)) {
+        return slot;
+      }
+      if (attempt % kMaxHazardSlots == kMaxHazardSlots - 1) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Откладывает освобождение цепочки first..last, связанной через retired_next_
+  void Retire(Node *first, Node *last, size_t count) noexcept {
+    last->retired_next_ = retired_.load(std::memory_order_relaxed);
+    while (!retired_.compare_exchange_weak(last->retired_next_, first,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    if (retired_count_.fetch_add(count, std::memory_order_relaxed) + count >=
+        kScanThreshold) {
+      Scan();
+    }
+  }
+
+  // Освобождает узлы, не защищённые ни одним hazard pointer
+  void Scan() noexcept {
+    Node *retired = retired_.exchange(nullptr, std::memory_order_acquire);
+    if (retired == nullptr) {
+      return;
+    }
+    std::array<Node *, kMaxHazardSlots> hazards;
+    for (size_t i = 0; i < kMaxHazardSlots; ++i) {
+      hazards[i] = hazards_[i].pointer_.load();
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    size_t scanned = 0;
+    Node *kept_first = nullptr;
+    Node *kept_last = nullptr;
+    size_t kept = 0;
+    while (retired != nullptr) {
+      Node *node = std::exchange(retired, retired->retired_next_);
+      ++scanned;
+      if (std::binary_search(hazards.begin(), hazards.end(), node)) {
+        node->retired_next_ = kept_first;
+        kept_first = node;
+        kept_last = kept_last == nullptr ? node : kept_last;
+        ++kept;
+      } else {
+        delete node;
+      }
+    }
+    retired_count_.fetch_sub(scanned, std::memory_order_relaxed);
+    if (kept_first != nullptr) {
+      kept_last->retired_next_ = retired_.load(std::memory_order_relaxed);
+      while (!retired_.compare_exchange_weak(kept_last->retired_next_,
+                                             kept_first,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+      }
+      retired_count_.fetch_add(kept, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename Next>
+  static void DeleteChain(Node *node, Next next) noexcept {
+    while (node != nullptr) {
+      delete std::exchange(node, next(node));
+    }
+  }
+
+  alignas(64) std::atomic<Node *> head_{nullptr};
+  alignas(64) std::atomic<size_t> size_{0};
+  alignas(64) std::atomic<Node *> retired_{nullptr};
+  std::atomic<size_t> retired_count_{0};
+  std::array<HazardSlot, kMaxHazardSlots> hazards_;
+};
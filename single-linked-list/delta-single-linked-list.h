@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Сжатый односвязный список целых чисел. Элементы хранятся в цепочке блоков:
+// блок содержит первый элемент как есть, а каждый следующий — разностью с
+// предыдущим в кодировке zigzag + varint. Для близких соседних значений это
+// 1–2 байта на элемент вместо узла с указателем. Итератор декодирует значения
+// на лету и возвращает их по значению, поэтому элементы доступны только для
+// чтения. PushFront и PopFront сдвигают байты первого блока и выполняются за
+// O(ChunkBytes), PushBack дописывает в последний блок. Изменения делают
+// недействительными итераторы на изменённый блок. По умолчанию блок 64-битных
+// значений занимает 256 байт
+template <typename Type, size_t ChunkBytes = 224>
+class DeltaSingleLinkedList {
+  static_assert(std::is_integral_v<Type> && !std::is_same_v<Type, bool>,
+                "DeltaSingleLinkedList stores integral types");
+
+  using Unsigned = std::make_unsigned_t<Type>;
+  static constexpr size_t kMaxEncodedBytes =
+      (std::numeric_limits<Unsigned>::digits + 6) / 7;
+
+  static_assert(ChunkBytes >= kMaxEncodedBytes,
+                "Chunk must fit at least one encoded difference");
+
+  struct Chunk {
+    Chunk *next_chunk_ = nullptr;
+    Type first_;
+    Type last_;
+    // Число элементов блока, включая first_
+    uint32_t count_ = 1;
+    // Число занятых байт в bytes_
+    uint32_t used_ = 0;
+    uint8_t bytes_[ChunkBytes];
+
+    explicit Chunk(Type value) noexcept : first_(value), last_(value) {}
+  };
+
+  // Разность to - from по модулю 2^N, закодированная в out. Возвращает длину
+  static size_t EncodeDelta(Type from, Type to, uint8_t *out) noexcept {
+    const auto delta = static_cast<Unsigned>(static_cast<Unsigned>(to) -
+                                             static_cast<Unsigned>(from));
+    const bool negative =
+        (delta >> (std::numeric_limits<Unsigned>::digits - 1)) != 0;
+    auto zigzag = static_cast<Unsigned>(static_cast<Unsigned>(delta << 1) ^
+                                        (negative ? ~Unsigned{0} : Unsigned{0}));
+    size_t length = 0;
+    while (zigzag >= 0x80) {
+      out[length++] = static_cast<uint8_t>(zigzag | 0x80);
+      zigzag = static_cast<Unsigned>(zigzag >> 7);
+    }
+    out[length++] = static_cast<uint8_t>(zigzag);
+    return length;
+  }
+
+  // Прибавляет к value разность, закодированную с позиции offset, и сдвигает
+  // offset за неё
+  static Type ApplyDelta(Type value, const uint8_t *bytes,
+                         uint32_t &offset) noexcept {
+    Unsigned zigzag = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      const uint8_t byte = bytes[offset++];
+      zigzag = static_cast<Unsigned>(
+          zigzag | static_cast<Unsigned>(static_cast<Unsigned>(byte & 0x7F) << shift));
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+    const auto delta = static_cast<Unsigned>(
+        static_cast<Unsigned>(zigzag >> 1) ^ ((zigzag & 1) ? ~Unsigned{0} : Unsigned{0}));
+    return static_cast<Type>(static_cast<Unsigned>(static_cast<Unsigned>(value) + delta));
+  }
+
+  // Значения вычисляются при разыменовании, поэтому по правилам C++17 итератор
+  // относится к категории ввода. Повторный обход при этом возможен, что
+  // отражает iterator_concept
+  class BasicIterator {
+    friend class DeltaSingleLinkedList;
+    const Chunk *chunk_ = nullptr;
+    uint32_t index_ = 0;
+    uint32_t offset_ = 0;
+    Type value_{};
+
+    explicit BasicIterator(const Chunk *chunk) noexcept
+        : chunk_(chunk), value_(chunk != nullptr ? chunk->first_ : Type{}) {}
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Type *;
+    using reference = Type;
+
+    BasicIterator() = default;
+
+    [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+      return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+    }
+
+    [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(chunk_);
+      if (++index_ < chunk_->count_) {
+        value_ = ApplyDelta(value_, chunk_->bytes_, offset_);
+      } else {
+        chunk_ = chunk_->next_chunk_;
+        index_ = 0;
+        offset_ = 0;
+        value_ = chunk_ != nullptr ? chunk_->first_ : Type{};
+      }
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(chunk_);
+      return value_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(chunk_);
+      return &value_;
+    }
+  };
+
+ public:
+  using ConstIterator = BasicIterator;
+  using Iterator = ConstIterator;
+
+  DeltaSingleLinkedList() = default;
+
+  DeltaSingleLinkedList(std::initializer_list<Type> values) {
+    AppendCopies(values.begin(), values.end());
+  }
+
+  template <typename InputIt,
+            typename = std::enable_if_t<std::is_convertible_v<
+                typename std::iterator_traits<InputIt>::iterator_category,
+                std::input_iterator_tag>>>
+  DeltaSingleLinkedList(InputIt first, InputIt last) {
+    AppendCopies(first, last);
+  }
+
+  // Блоки копируются целиком, без перекодирования
+  DeltaSingleLinkedList(const DeltaSingleLinkedList &other) {
+    Chunk **link = &head_;
+    try {
+      for (const Chunk *chunk = other.head_; chunk != nullptr;
+           chunk = chunk->next_chunk_) {
+        *link = new Chunk(*chunk);
+        (*link)->next_chunk_ = nullptr;
+        tail_ = *link;
+        link = &tail_->next_chunk_;
+        ++chunk_count_;
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    size_ = other.size_;
+  }
+
+  DeltaSingleLinkedList(DeltaSingleLinkedList &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        tail_(std::exchange(other.tail_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        chunk_count_(std::exchange(other.chunk_count_, 0)) {}
+
+  DeltaSingleLinkedList &operator=(const DeltaSingleLinkedList &rhs) {
+    if (this != &rhs) {
+      DeltaSingleLinkedList temp_(rhs);
+      swap(temp_);
+    }
+    return *this;
+  }
+
+  DeltaSingleLinkedList &operator=(DeltaSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  ~DeltaSingleLinkedList() { Clear(); }
+
+  void swap(DeltaSingleLinkedList &other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+    std::swap(chunk_count_, other.chunk_count_);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  // Память, занятая блоками, в байтах
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept {
+    return chunk_count_ * sizeof(Chunk);
+  }
+
+  [[nodiscard]] Type Front() const noexcept {
+    assert(!IsEmpty());
+    return head_->first_;
+  }
+
+  // Сдвигает байты первого блока, а если в нём нет места, начинает новый блок
+  void PushFront(Type value) {
+    uint8_t encoded[kMaxEncodedBytes];
+    if (head_ != nullptr) {
+      const size_t length = EncodeDelta(value, head_->first_, encoded);
+      if (head_->used_ + length <= ChunkBytes) {
+        std::memmove(head_->bytes_ + length, head_->bytes_, head_->used_);
+        std::memcpy(head_->bytes_, encoded, length);
+        head_->used_ += static_cast<uint32_t>(length);
+        head_->first_ = value;
+        ++head_->count_;
+        ++size_;
+        return;
+      }
+    }
+    Chunk *chunk = new Chunk(value);
+    chunk->next_chunk_ = head_;
+    head_ = chunk;
+    if (tail_ == nullptr) {
+      tail_ = chunk;
+    }
+    ++chunk_count_;
+    ++size_;
+  }
+
+  // Дописывает разность в последний блок, а если в нём нет места, начинает новый
+  void PushBack(Type value) {
+    uint8_t encoded[kMaxEncodedBytes];
+    if (tail_ != nullptr) {
+      const size_t length = EncodeDelta(tail_->last_, value, encoded);
+      if (tail_->used_ + length <= ChunkBytes) {
+        std::memcpy(tail_->bytes_ + tail_->used_, encoded, length);
+        tail_->used_ += static_cast<uint32_t>(length);
+        tail_->last_ = value;
+        ++tail_->count_;
+        ++size_;
+        return;
+      }
+    }
+    Chunk *chunk = new Chunk(value);
+    (tail_ != nullptr ? tail_->next_chunk_ : head_) = chunk;
+    tail_ = chunk;
+    ++chunk_count_;
+    ++size_;
+  }
+
+  void PopFront() noexcept {
+    assert(!IsEmpty());
+    if (head_->count_ == 1) {
+      delete std::exchange(head_, head_->next_chunk_);
+      if (head_ == nullptr) {
+        tail_ = nullptr;
+      }
+      --chunk_count_;
+    } else {
+      uint32_t length = 0;
+      head_->first_ = ApplyDelta(head_->first_, head_->bytes_, length);
+      head_->used_ -= length;
+      std::memmove(head_->bytes_, head_->bytes_ + length, head_->used_);
+      --head_->count_;
+    }
+    --size_;
+  }
+
+  void Clear() noexcept {
+    while (head_ != nullptr) {
+      delete std::exchange(head_, head_->next_chunk_);
+    }
+    tail_ = nullptr;
+    size_ = 0;
+    chunk_count_ = 0;
+  }
+
+ private:
+  template <typename I>
+  void AppendCopies(I begin_, I end_) {
+    try {
+      for (; begin_ != end_; ++begin_) {
+        PushBack(*begin_);
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  Chunk *head_ = nullptr;
+  Chunk *tail_ = nullptr;
+  size_t size_ = 0;
+  size_t chunk_count_ = 0;
+};
+
+template <typename Type, size_t ChunkBytes>
+void swap(DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+          DeltaSingleLinkedList<Type, ChunkBytes> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator==(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+                const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator!=(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+                const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator<(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+               const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator<=(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+                const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator>(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+               const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type, size_t ChunkBytes>
+bool operator>=(const DeltaSingleLinkedList<Type, ChunkBytes> &lhs,
+                const DeltaSingleLinkedList<Type, ChunkBytes> &rhs) {
+  return !(lhs < rhs);
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Связь, встраиваемая в объект, который помещается в IntrusiveSingleLinkedList.
+// Копия объекта не наследует место оригинала в списке, поэтому копирование
+// и присваивание связь не переносят
+template <typename Type>
+struct IntrusiveListHook {
+  Type *next_ = nullptr;
+  // У последнего объекта списка next_ тоже nullptr, поэтому принадлежность
+  // списку хранится отдельно: так повторная вставка обнаруживается
+  bool linked_ = false;
+
+  IntrusiveListHook() = default;
+  IntrusiveListHook(const IntrusiveListHook &) noexcept {}
+  IntrusiveListHook &operator=(const IntrusiveListHook &) noexcept {
+    return *this;
+  }
+
+  [[nodiscard]] bool IsLinked() const noexcept { return linked_; }
+};
+
+// Интрузивный односвязный список: объекты связываются через свою связь Hook
+// и не копируются. Список не владеет объектами и не выделяет память, объект
+// должен жить, пока находится в списке, и может состоять в одном списке на
+// каждую свою связь. PushFront, PopFront, InsertAfter и EraseAfter выполняются
+// за O(1). Удалённым объектам связь сбрасывается
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+class IntrusiveSingleLinkedList {
+  [[nodiscard]] static Type *&Next(Type *object) noexcept {
+    return (object->*Hook).next_;
+  }
+
+  static void Link(Type *object, Type *next) noexcept {
+    assert(!(object->*Hook).linked_);
+    (object->*Hook).next_ = next;
+    (object->*Hook).linked_ = true;
+  }
+
+  // Сбрасывает связь объекта и возвращает следующий за ним
+  static Type *Unlink(Type *object) noexcept {
+    (object->*Hook).linked_ = false;
+    return std::exchange(Next(object), nullptr);
+  }
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class IntrusiveSingleLinkedList;
+    Type *object_ = nullptr;
+    explicit BasicIterator(Type *object) noexcept : object_(object) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    BasicIterator &operator=(const BasicIterator &rhs) = default;
+
+    BasicIterator(const BasicIterator<Type> &other) noexcept
+        : object_(other.object_) {}
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return object_ == rhs.object_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return object_ == rhs.object_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(object_);
+      object_ = Next(object_);
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(object_);
+      return *object_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(object_);
+      return object_;
+    }
+  };
+
+ public:
+  using Iterator = BasicIterator<Type>;
+  using ConstIterator = BasicIterator<const Type>;
+
+  IntrusiveSingleLinkedList() = default;
+
+  // Объект не может стоять в двух списках через одну связь
+  IntrusiveSingleLinkedList(const IntrusiveSingleLinkedList &) = delete;
+  IntrusiveSingleLinkedList &operator=(const IntrusiveSingleLinkedList &) = delete;
+
+  IntrusiveSingleLinkedList(IntrusiveSingleLinkedList &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  IntrusiveSingleLinkedList &operator=(IntrusiveSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Clear();
+      head_ = std::exchange(rhs.head_, nullptr);
+      size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+  }
+
+  // Сбрасывает связи оставшихся объектов, сами объекты не уничтожаются
+  ~IntrusiveSingleLinkedList() { Clear(); }
+
+  void swap(IntrusiveSingleLinkedList &other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  [[nodiscard]] Iterator begin() noexcept { return Iterator(head_); }
+
+  [[nodiscard]] Iterator end() noexcept { return Iterator(nullptr); }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] Type &Front() noexcept {
+    assert(!IsEmpty());
+    return *head_;
+  }
+
+  [[nodiscard]] const Type &Front() const noexcept {
+    assert(!IsEmpty());
+    return *head_;
+  }
+
+  // Связывает object с началом списка без копирования
+  void PushFront(Type &object) noexcept {
+    Link(&object, head_);
+    head_ = &object;
+    ++size_;
+  }
+
+  // Отцепляет первый объект и возвращает ссылку на него
+  Type &PopFront() noexcept {
+    assert(!IsEmpty());
+    Type *object = head_;
+    head_ = Unlink(object);
+    --size_;
+    return *object;
+  }
+
+  // Связывает object после pos и возвращает итератор на него
+  Iterator InsertAfter(ConstIterator pos, Type &object) noexcept {
+    assert(pos.object_ != nullptr);
+    Type *previous = const_cast<Type *>(pos.object_);
+    Link(&object, Next(previous));
+    Next(previous) = &object;
+    ++size_;
+    return Iterator(&object);
+  }
+
+  // Отцепляет объект, следующий за pos, и возвращает итератор на объект за ним
+  Iterator EraseAfter(ConstIterator pos) noexcept {
+    assert(pos.object_ != nullptr && Next(const_cast<Type *>(pos.object_)));
+    Type *&link = Next(const_cast<Type *>(pos.object_));
+    link = Unlink(link);
+    --size_;
+    return Iterator(link);
+  }
+
+  // Отцепляет все объекты за O(n), сбрасывая их связи
+  void Clear() noexcept {
+    while (head_ != nullptr) {
+      head_ = Unlink(head_);
+    }
+    size_ = 0;
+  }
+
+ private:
+  Type *head_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+void swap(IntrusiveSingleLinkedList<Type, Hook> &lhs,
+          IntrusiveSingleLinkedList<Type, Hook> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator==(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+                const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator!=(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+                const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator<(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+               const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator<=(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+                const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator>(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+               const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+bool operator>=(const IntrusiveSingleLinkedList<Type, Hook> &lhs,
+                const IntrusiveSingleLinkedList<Type, Hook> &rhs) {
+  return !(lhs < rhs);
+}
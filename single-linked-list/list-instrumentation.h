@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Операции списка, длительность которых измеряет ListInstrumentation
+enum class ListOperation {
+  kPushFront,
+  kPushBack,
+  kClear,
+  kCopy,
+  kAssign,
+  kSort,
+  kMerge,
+  kUnique,
+  kCompact,
+  kCount
+};
+
+struct ListOperationStats {
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+// Снимок статистики одного списка
+struct ListStats {
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  uint64_t iterator_increments = 0;
+  // Узлы списка вместе с оценкой накладных расходов аллокатора
+  size_t bytes_held = 0;
+  std::array<ListOperationStats, static_cast<size_t>(ListOperation::kCount)>
+      operations{};
+
+  [[nodiscard]] const ListOperationStats &operator[](
+      ListOperation op) const noexcept {
+    return operations[static_cast<size_t>(op)];
+  }
+};
+
+// Политика по умолчанию: все обработчики пусты и удаляются компилятором
+struct NoListInstrumentation {
+  static constexpr bool kEnabled = false;
+
+  struct ScopedTimer {};
+
+  void OnAllocate(size_t) noexcept {}
+  void OnDeallocate(size_t) noexcept {}
+  void OnIncrement() noexcept {}
+  [[nodiscard]] ScopedTimer Measure(ListOperation) noexcept { return {}; }
+};
+
+// Считает выделения и освобождения узлов, шаги итераторов и время операций.
+// Счётчики атомарны, поэтому несколько потоков могут одновременно обходить
+// константный список
+class ListInstrumentation {
+ public:
+  static constexpr bool kEnabled = true;
+
+  class ScopedTimer {
+   public:
+    ScopedTimer(ListInstrumentation &owner, ListOperation op) noexcept
+        : owner_(owner), op_(op) {}
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer() {
+      const auto elapsed = std::chrono::steady_clock::now() - start_;
+      owner_.Record(op_, static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+   private:
+    ListInstrumentation &owner_;
+    ListOperation op_;
+    std::chrono::steady_clock::time_point start_ =
+        std::chrono::steady_clock::now();
+  };
+
+  ListInstrumentation() = default;
+
+  // Статистика принадлежит объекту списка и не копируется вместе с ним
+  ListInstrumentation(const ListInstrumentation &) noexcept {}
+  ListInstrumentation &operator=(const ListInstrumentation &) noexcept {
+    return *this;
+  }
+
+  void OnAllocate(size_t nodes) noexcept {
+    allocations_.fetch_add(nodes, std::memory_order_relaxed);
+  }
+
+  void OnDeallocate(size_t nodes) noexcept {
+    deallocations_.fetch_add(nodes, std::memory_order_relaxed);
+  }
+
+  void OnIncrement() noexcept {
+    iterator_increments_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] ScopedTimer Measure(ListOperation op) noexcept {
+    return ScopedTimer(*this, op);
+  }
+
+  [[nodiscard]] ListStats Snapshot() const noexcept {
+    ListStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+    stats.iterator_increments =
+        iterator_increments_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < operations_.size(); ++i) {
+      stats.operations[i].calls =
+          operations_[i].calls.load(std::memory_order_relaxed);
+      stats.operations[i].total_ns =
+          operations_[i].total_ns.load(std::memory_order_relaxed);
+      stats.operations[i].max_ns =
+          operations_[i].max_ns.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+  void Reset() noexcept {
+    allocations_.store(0, std::memory_order_relaxed);
+    deallocations_.store(0, std::memory_order_relaxed);
+    iterator_increments_.store(0, std::memory_order_relaxed);
+    for (auto &op : operations_) {
+      op.calls.store(0, std::memory_order_relaxed);
+      op.total_ns.store(0, std::memory_order_relaxed);
+      op.max_ns.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct AtomicOperationStats {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+  };
+
+  void Record(ListOperation op, uint64_t ns) noexcept {
+    auto &stats = operations_[static_cast<size_t>(op)];
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t max = stats.max_ns.load(std::memory_order_relaxed);
+    while (ns > max &&
+           !stats.max_ns.compare_exchange_weak(max, ns,
+                                               std::memory_order_relaxed)) {
+    }
+  }
+
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> deallocations_{0};
+  std::atomic<uint64_t> iterator_increments_{0};
+  std::array<AtomicOperationStats, static_cast<size_t>(ListOperation::kCount)>
+      operations_;
+};
@@ -0,0 +1,491 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "node-pool-allocator.h"
+#include "single-linked-list.h"
+
+// Ленивые представления над списками и любыми диапазонами с begin()/end().
+// Представления не копируют элементы и не выделяют память: элементы
+// вычисляются при обходе. Стадии соединяются через | и завершаются Collect:
+//   auto list = source | list_views::Filter(pred) | list_views::Transform(f)
+//                      | list_views::Take(10) | list_views::Collect();
+// Collect по умолчанию строит список поверх арены узлов, другой аллокатор
+// передаётся аргументом: list_views::Collect(std::allocator<char>())
+// Диапазон-lvalue хранится по ссылке и должен пережить представление,
+// rvalue перемещается внутрь представления. Итераторы ссылаются на функции,
+// хранящиеся в представлении, и недействительны после его перемещения
+namespace list_views {
+
+namespace detail {
+
+template <typename Range>
+class RefView {
+ public:
+  explicit RefView(Range &range) noexcept : range_(std::addressof(range)) {}
+
+  [[nodiscard]] auto begin() const { return range_->begin(); }
+  [[nodiscard]] auto end() const { return range_->end(); }
+
+ private:
+  Range *range_;
+};
+
+template <typename Range>
+using ViewOf = std::conditional_t<std::is_lvalue_reference_v<Range>,
+                                  RefView<std::remove_reference_t<Range>>,
+                                  std::remove_cv_t<std::remove_reference_t<Range>>>;
+
+template <typename Range>
+ViewOf<Range &&> AsView(Range &&range) {
+  if constexpr (std::is_lvalue_reference_v<Range &&>) {
+    return RefView<std::remove_reference_t<Range>>(range);
+  } else {
+    return std::forward<Range>(range);
+  }
+}
+
+template <typename View>
+using BaseIterator = decltype(std::declval<const View &>().begin());
+
+template <typename Iterator>
+using BaseReference = typename std::iterator_traits<Iterator>::reference;
+
+// Итераторы, разыменование которых возвращает временное значение, по
+// правилам C++17 могут быть только итераторами ввода. Повторный обход при
+// этом возможен, что отражает iterator_concept
+template <typename Reference>
+using CategoryFor = std::conditional_t<std::is_reference_v<Reference>,
+                                       std::forward_iterator_tag,
+                                       std::input_iterator_tag>;
+
+// Стадия конвейера, применяемая к диапазону через |
+template <typename Adaptor>
+struct Closure {
+  Adaptor adaptor_;
+};
+
+template <typename Adaptor>
+Closure<Adaptor> MakeClosure(Adaptor adaptor) {
+  return {std::move(adaptor)};
+}
+
+template <typename Range, typename Adaptor>
+auto operator|(Range &&range, Closure<Adaptor> closure) {
+  return closure.adaptor_(std::forward<Range>(range));
+}
+
+}  // namespace detail
+
+// Элементы base, для которых pred возвращает true
+template <typename View, typename Pred>
+class FilterView {
+  using Base = detail::BaseIterator<View>;
+
+ public:
+  class Iterator {
+    friend class FilterView;
+
+   public:
+    using iterator_category = detail::CategoryFor<detail::BaseReference<Base>>;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<Base>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = detail::BaseReference<Base>;
+
+    Iterator() = default;
+
+    [[nodiscard]] bool operator==(const Iterator &rhs) const {
+      return current_ == rhs.current_;
+    }
+
+    [[nodiscard]] bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    Iterator &operator++() {
+      ++current_;
+      SkipRejected();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const { return *current_; }
+
+   private:
+    Iterator(Base current, Base end, const Pred *pred)
+        : current_(std::move(current)), end_(std::move(end)), pred_(pred) {
+      SkipRejected();
+    }
+
+    void SkipRejected() {
+      while (current_ != end_ && !std::invoke(*pred_, *current_)) {
+        ++current_;
+      }
+    }
+
+    Base current_{};
+    Base end_{};
+    const Pred *pred_ = nullptr;
+  };
+
+  FilterView(View base, Pred pred)
+      : base_(std::move(base)), pred_(std::move(pred)) {}
+
+  // Пропускает начальные отвергнутые элементы, поэтому выполняется за O(k)
+  [[nodiscard]] Iterator begin() const {
+    return Iterator(base_.begin(), base_.end(), &pred_);
+  }
+
+  [[nodiscard]] Iterator end() const {
+    return Iterator(base_.end(), base_.end(), &pred_);
+  }
+
+ private:
+  View base_;
+  Pred pred_;
+};
+
+// Результаты func для каждого элемента base
+template <typename View, typename Func>
+class TransformView {
+  using Base = detail::BaseIterator<View>;
+
+ public:
+  class Iterator {
+    friend class TransformView;
+
+   public:
+    using reference =
+        std::invoke_result_t<const Func &, detail::BaseReference<Base>>;
+    using iterator_category = detail::CategoryFor<reference>;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+
+    Iterator() = default;
+
+    [[nodiscard]] bool operator==(const Iterator &rhs) const {
+      return current_ == rhs.current_;
+    }
+
+    [[nodiscard]] bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    Iterator &operator++() {
+      ++current_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const {
+      return std::invoke(*func_, *current_);
+    }
+
+   private:
+    Iterator(Base current, const Func *func)
+        : current_(std::move(current)), func_(func) {}
+
+    Base current_{};
+    const Func *func_ = nullptr;
+  };
+
+  TransformView(View base, Func func)
+      : base_(std::move(base)), func_(std::move(func)) {}
+
+  [[nodiscard]] Iterator begin() const {
+    return Iterator(base_.begin(), &func_);
+  }
+
+  [[nodiscard]] Iterator end() const { return Iterator(base_.end(), &func_); }
+
+ private:
+  View base_;
+  Func func_;
+};
+
+// Не более count первых элементов base
+template <typename View>
+class TakeView {
+  using Base = detail::BaseIterator<View>;
+
+ public:
+  class Iterator {
+    friend class TakeView;
+
+   public:
+    using iterator_category = detail::CategoryFor<detail::BaseReference<Base>>;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<Base>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = detail::BaseReference<Base>;
+
+    Iterator() = default;
+
+    // Все итераторы в конечном положении равны между собой
+    [[nodiscard]] bool operator==(const Iterator &rhs) const {
+      if (IsEnd() || rhs.IsEnd()) {
+        return IsEnd() == rhs.IsEnd();
+      }
+      return current_ == rhs.current_;
+    }
+
+    [[nodiscard]] bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    // Последний элемент не продвигает base: за ним могли бы вычисляться
+    // элементы, которые уже не нужны
+    Iterator &operator++() {
+      if (--remaining_ != 0) {
+        ++current_;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const { return *current_; }
+
+   private:
+    Iterator(Base current, Base end, size_t remaining)
+        : current_(std::move(current)), end_(std::move(end)),
+          remaining_(remaining) {}
+
+    [[nodiscard]] bool IsEnd() const {
+      return remaining_ == 0 || current_ == end_;
+    }
+
+    Base current_{};
+    Base end_{};
+    size_t remaining_ = 0;
+  };
+
+  TakeView(View base, size_t count) : base_(std::move(base)), count_(count) {}
+
+  [[nodiscard]] Iterator begin() const {
+    return Iterator(base_.begin(), base_.end(), count_);
+  }
+
+  [[nodiscard]] Iterator end() const {
+    return Iterator(base_.end(), base_.end(), 0);
+  }
+
+ private:
+  View base_;
+  size_t count_;
+};
+
+// Пары соответствующих элементов двух диапазонов до конца более короткого
+template <typename FirstView, typename SecondView>
+class ZipView {
+  using FirstBase = detail::BaseIterator<FirstView>;
+  using SecondBase = detail::BaseIterator<SecondView>;
+
+ public:
+  class Iterator {
+    friend class ZipView;
+
+   public:
+    using reference = std::pair<detail::BaseReference<FirstBase>,
+                                detail::BaseReference<SecondBase>>;
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type =
+        std::pair<typename std::iterator_traits<FirstBase>::value_type,
+                  typename std::iterator_traits<SecondBase>::value_type>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+
+    Iterator() = default;
+
+    // Итераторы, дошедшие до конца хотя бы одного диапазона, равны между собой
+    [[nodiscard]] bool operator==(const Iterator &rhs) const {
+      if (IsEnd() || rhs.IsEnd()) {
+        return IsEnd() == rhs.IsEnd();
+      }
+      return first_ == rhs.first_ && second_ == rhs.second_;
+    }
+
+    [[nodiscard]] bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    Iterator &operator++() {
+      ++first_;
+      ++second_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const {
+      return reference(*first_, *second_);
+    }
+
+   private:
+    Iterator(FirstBase first, FirstBase first_end, SecondBase second,
+             SecondBase second_end)
+        : first_(std::move(first)), first_end_(std::move(first_end)),
+          second_(std::move(second)), second_end_(std::move(second_end)) {}
+
+    [[nodiscard]] bool IsEnd() const {
+      return first_ == first_end_ || second_ == second_end_;
+    }
+
+    FirstBase first_{};
+    FirstBase first_end_{};
+    SecondBase second_{};
+    SecondBase second_end_{};
+  };
+
+  ZipView(FirstView first, SecondView second)
+      : first_(std::move(first)), second_(std::move(second)) {}
+
+  [[nodiscard]] Iterator begin() const {
+    return Iterator(first_.begin(), first_.end(), second_.begin(),
+                    second_.end());
+  }
+
+  [[nodiscard]] Iterator end() const {
+    return Iterator(first_.end(), first_.end(), second_.end(), second_.end());
+  }
+
+ private:
+  FirstView first_;
+  SecondView second_;
+};
+
+template <typename Range, typename Pred>
+[[nodiscard]] auto Filter(Range &&range, Pred pred) {
+  return FilterView<detail::ViewOf<Range &&>, Pred>(
+      detail::AsView(std::forward<Range>(range)), std::move(pred));
+}
+
+template <typename Pred>
+[[nodiscard]] auto Filter(Pred pred) {
+  return detail::MakeClosure([pred = std::move(pred)](auto &&range) {
+    return Filter(std::forward<decltype(range)>(range), pred);
+  });
+}
+
+template <typename Range, typename Func>
+[[nodiscard]] auto Transform(Range &&range, Func func) {
+  return TransformView<detail::ViewOf<Range &&>, Func>(
+      detail::AsView(std::forward<Range>(range)), std::move(func));
+}
+
+template <typename Func>
+[[nodiscard]] auto Transform(Func func) {
+  return detail::MakeClosure([func = std::move(func)](auto &&range) {
+    return Transform(std::forward<decltype(range)>(range), func);
+  });
+}
+
+template <typename Range>
+[[nodiscard]] auto Take(Range &&range, size_t count) {
+  return TakeView<detail::ViewOf<Range &&>>(
+      detail::AsView(std::forward<Range>(range)), count);
+}
+
+[[nodiscard]] inline auto Take(size_t count) {
+  return detail::MakeClosure([count](auto &&range) {
+    return Take(std::forward<decltype(range)>(range), count);
+  });
+}
+
+template <typename FirstRange, typename SecondRange>
+[[nodiscard]] auto Zip(FirstRange &&first, SecondRange &&second) {
+  return ZipView<detail::ViewOf<FirstRange &&>, detail::ViewOf<SecondRange &&>>(
+      detail::AsView(std::forward<FirstRange>(first)),
+      detail::AsView(std::forward<SecondRange>(second)));
+}
+
+// second хранится по тем же правилам, что и диапазоны стадий, и копируется
+// в представление, чтобы не ссылаться на временную стадию
+template <typename SecondRange>
+[[nodiscard]] auto Zip(SecondRange &&second) {
+  using SecondView = detail::ViewOf<SecondRange &&>;
+  return detail::MakeClosure(
+      [second = detail::AsView(std::forward<SecondRange>(second))](
+          auto &&first) {
+        using FirstRange = decltype(first);
+        return ZipView<detail::ViewOf<FirstRange>, SecondView>(
+            detail::AsView(std::forward<FirstRange>(first)), second);
+      });
+}
+
+namespace detail {
+
+// Представления этого файла: их обход вызывает функции пользователя
+template <typename Range>
+struct IsLazyView : std::false_type {};
+
+template <typename View, typename Pred>
+struct IsLazyView<FilterView<View, Pred>> : std::true_type {};
+
+template <typename View, typename Func>
+struct IsLazyView<TransformView<View, Func>> : std::true_type {};
+
+template <typename View>
+struct IsLazyView<TakeView<View>> : std::true_type {};
+
+template <typename FirstView, typename SecondView>
+struct IsLazyView<ZipView<FirstView, SecondView>> : std::true_type {};
+
+}  // namespace detail
+
+// Завершающая стадия: строит SingleLinkedList из элементов диапазона. По
+// умолчанию узлы размещаются в собственной арене списка (NodePoolAllocator):
+// представление обходится один раз, и узлы занимают несколько растущих блоков
+// арены подряд. Обычный контейнер без стадий проходится дважды, и арена
+// выделяет все узлы одним блоком. Функции стадий вызываются ровно по одному
+// разу на элемент
+template <typename Allocator = NodePoolAllocator<char>>
+[[nodiscard]] auto Collect(const Allocator &alloc = Allocator()) {
+  return detail::MakeClosure([alloc](auto &&range) {
+    using Iterator = decltype(range.begin());
+    using Value = typename std::iterator_traits<Iterator>::value_type;
+    using ValueAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+    using List = SingleLinkedList<Value, ValueAllocator>;
+    if constexpr (detail::IsLazyView<std::decay_t<decltype(range)>>::value) {
+      List list{ValueAllocator(alloc)};
+      for (auto &&value : range) {
+        list.EmplaceBack(std::forward<decltype(value)>(value));
+      }
+      return list;
+    } else {
+      return List(range.begin(), range.end(), ValueAllocator(alloc));
+    }
+  });
+}
+
+}  // namespace list_views
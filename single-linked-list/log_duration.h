@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#define PROFILE_CONCAT_INTERNAL(X, Y) X##Y
+#define PROFILE_CONCAT(X, Y) PROFILE_CONCAT_INTERNAL(X, Y)
+#define UNIQUE_VAR_NAME_PROFILE PROFILE_CONCAT(profileGuard, __LINE__)
+#define LOG_DURATION(x, stream) LogDuration UNIQUE_VAR_NAME_PROFILE(x, stream)
+
+// Выводит в поток время жизни объекта
+class LogDuration {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit LogDuration(std::string id, std::ostream &stream = std::cerr)
+      : id_(std::move(id)), stream_(stream) {}
+
+  LogDuration(const LogDuration &) = delete;
+  LogDuration &operator=(const LogDuration &) = delete;
+
+  ~LogDuration() {
+    using namespace std::chrono;
+    const auto dur = Clock::now() - start_time_;
+    stream_ << id_ << ": " << duration_cast<milliseconds>(dur).count()
+            << " ms" << std::endl;
+  }
+
+ private:
+  const std::string id_;
+  const Clock::time_point start_time_ = Clock::now();
+  std::ostream &stream_;
+};
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "single-linked-list.h"
+
+namespace detail {
+
+// Формат файла: заголовок, затем записи {смещение следующей записи, значение}
+// в порядке обхода. Смещения отсчитываются от начала файла, 0 — конец списка.
+// Порядок байтов и размер значения — как у записавшей файл программы
+struct MappedListHeader {
+  static constexpr char kMagic[8] = {'S', 'L', 'L', 'I', 'S', 'T', '0', '1'};
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8];
+  uint32_t byte_order;
+  uint32_t value_size;
+  uint64_t value_align;
+  uint64_t count;
+  uint64_t head_offset;
+};
+
+constexpr uint64_t RoundUp(uint64_t value, uint64_t alignment) noexcept {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Расположение записи в файле. Запись выровнена так, чтобы значение можно
+// было читать прямо из отображения
+template <typename Type>
+struct MappedListLayout {
+  static constexpr uint64_t kRecordAlign =
+      std::max<uint64_t>(alignof(uint64_t), alignof(Type));
+  static constexpr uint64_t kValueOffset = RoundUp(sizeof(uint64_t), alignof(Type));
+  static constexpr uint64_t kRecordSize =
+      RoundUp(kValueOffset + sizeof(Type), kRecordAlign);
+  static constexpr uint64_t kFirstRecordOffset =
+      RoundUp(sizeof(MappedListHeader), kRecordAlign);
+};
+
+}  // namespace detail
+
+// Записывает элементы list в файл path в формате MappedSingleLinkedList
+template <typename Type, typename Allocator, typename Instrumentation>
+void SaveSingleLinkedList(
+    const SingleLinkedList<Type, Allocator, Instrumentation> &list,
+    const std::string &path) {
+  static_assert(std::is_trivially_copyable_v<Type>,
+                "Binary lists store trivially copyable types");
+  using Layout = detail::MappedListLayout<Type>;
+  constexpr uint64_t kFirst = Layout::kFirstRecordOffset;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot open " + path + " for writing");
+  }
+
+  detail::MappedListHeader header{};
+  std::memcpy(header.magic, detail::MappedListHeader::kMagic, sizeof(header.magic));
+  header.byte_order = detail::MappedListHeader::kByteOrderMark;
+  header.value_size = sizeof(Type);
+  header.value_align = alignof(Type);
+  header.count = list.GetSize();
+  header.head_offset = list.IsEmpty() ? 0 : kFirst;
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  const char padding[kFirst - sizeof(header) + 1] = {};
+  out.write(padding, kFirst - sizeof(header));
+
+  char record[Layout::kRecordSize] = {};
+  uint64_t offset = kFirst;
+  size_t written = 0;
+  for (const Type &value : list) {
+    offset += Layout::kRecordSize;
+    const uint64_t next_offset = ++written == list.GetSize() ? 0 : offset;
+    std::memcpy(record, &next_offset, sizeof(next_offset));
+    std::memcpy(record + Layout::kValueOffset, &value, sizeof(Type));
+    out.write(record, sizeof(record));
+  }
+  out.flush();
+  if (!out) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+// Неизменяемое представление списка, сохранённого SaveSingleLinkedList.
+// Файл отображается в память целиком, элементы читаются прямо из отображения
+// без копирования и выделения памяти. Конструктор проверяет заголовок и
+// размер файла, Validate дополнительно проверяет все связи
+template <typename Type>
+class MappedSingleLinkedList {
+  static_assert(std::is_trivially_copyable_v<Type>,
+                "Binary lists store trivially copyable types");
+
+  using Layout = detail::MappedListLayout<Type>;
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class MappedSingleLinkedList;
+    const std::byte *base_ = nullptr;
+    uint64_t offset_ = 0;
+
+    BasicIterator(const std::byte *base, uint64_t offset) noexcept
+        : base_(base), offset_(offset) {}
+
+    [[nodiscard]] const Type &GetValue() const noexcept {
+      return *reinterpret_cast<const Type *>(base_ + offset_ +
+                                             Layout::kValueOffset);
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    // Все итераторы end() равны между собой
+    [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+      return offset_ == rhs.offset_ && (offset_ == 0 || base_ == rhs.base_);
+    }
+
+    [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(offset_ != 0);
+      offset_ = ReadNextOffset(base_, offset_);
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(offset_ != 0);
+      return GetValue();
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(offset_ != 0);
+      return &GetValue();
+    }
+  };
+
+ public:
+  using ConstIterator = BasicIterator<const Type>;
+  using Iterator = ConstIterator;
+
+  explicit MappedSingleLinkedList(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    length_ = static_cast<size_t>(info.st_size);
+    if (length_ < sizeof(detail::MappedListHeader)) {
+      ::close(fd);
+      throw std::runtime_error(path + " is not a binary list file");
+    }
+    void *address = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), "mmap " + path);
+    }
+    base_ = static_cast<const std::byte *>(address);
+    // Записи идут подряд в порядке обхода
+    ::madvise(address, length_, MADV_SEQUENTIAL);
+
+    const auto &header = *reinterpret_cast<const detail::MappedListHeader *>(base_);
+    const uint64_t expected_length =
+        Layout::kFirstRecordOffset + header.count * Layout::kRecordSize;
+    if (std::memcmp(header.magic, detail::MappedListHeader::kMagic,
+                    sizeof(header.magic)) != 0 ||
+        header.byte_order != detail::MappedListHeader::kByteOrderMark ||
+        header.value_size != sizeof(Type) || header.value_align != alignof(Type) ||
+        header.count > length_ / Layout::kRecordSize || expected_length != length_ ||
+        (header.count == 0) != (header.head_offset == 0) ||
+        !IsRecordOffset(header.head_offset)) {
+      Unmap();
+      throw std::runtime_error(path + " does not hold a list of this type");
+    }
+    size_ = header.count;
+    head_offset_ = header.head_offset;
+  }
+
+  MappedSingleLinkedList(const MappedSingleLinkedList &) = delete;
+  MappedSingleLinkedList &operator=(const MappedSingleLinkedList &) = delete;
+
+  MappedSingleLinkedList(MappedSingleLinkedList &&other) noexcept
+      : base_(std::exchange(other.base_, nullptr)),
+        length_(std::exchange(other.length_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        head_offset_(std::exchange(other.head_offset_, 0)) {}
+
+  MappedSingleLinkedList &operator=(MappedSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Unmap();
+      base_ = std::exchange(rhs.base_, nullptr);
+      length_ = std::exchange(rhs.length_, 0);
+      size_ = std::exchange(rhs.size_, 0);
+      head_offset_ = std::exchange(rhs.head_offset_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedSingleLinkedList() { Unmap(); }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(base_, head_offset_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(base_, 0);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  // Проходит все связи за O(n): каждое смещение указывает на запись внутри
+  // файла, и цепочка содержит ровно GetSize() элементов
+  [[nodiscard]] bool Validate() const noexcept {
+    uint64_t offset = head_offset_;
+    for (size_t i = 0; i < size_; ++i) {
+      if (!IsRecordOffset(offset) || offset == 0) {
+        return false;
+      }
+      offset = ReadNextOffset(base_, offset);
+    }
+    return offset == 0;
+  }
+
+ private:
+  [[nodiscard]] static uint64_t ReadNextOffset(const std::byte *base,
+                                               uint64_t offset) noexcept {
+    return *reinterpret_cast<const uint64_t *>(base + offset);
+  }
+
+  [[nodiscard]] bool IsRecordOffset(uint64_t offset) const noexcept {
+    constexpr uint64_t kFirst = Layout::kFirstRecordOffset;
+    return offset == 0 || (offset >= kFirst && offset < length_ &&
+                           (offset - kFirst) % Layout::kRecordSize == 0);
+  }
+
+  void Unmap() noexcept {
+    if (base_ != nullptr) {
+      ::munmap(const_cast<std::byte *>(base_), length_);
+      base_ = nullptr;
+    }
+  }
+
+  const std::byte *base_ = nullptr;
+  size_t length_ = 0;
+  size_t size_ = 0;
+  uint64_t head_offset_ = 0;
+};
+
+template <typename Type>
+bool operator==(const MappedSingleLinkedList<Type> &lhs,
+                const MappedSingleLinkedList<Type> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type>
+bool operator!=(const MappedSingleLinkedList<Type> &lhs,
+                const MappedSingleLinkedList<Type> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const MappedSingleLinkedList<Type> &lhs,
+               const MappedSingleLinkedList<Type> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type>
+bool operator<=(const MappedSingleLinkedList<Type> &lhs,
+                const MappedSingleLinkedList<Type> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const MappedSingleLinkedList<Type> &lhs,
+               const MappedSingleLinkedList<Type> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const MappedSingleLinkedList<Type> &lhs,
+                const MappedSingleLinkedList<Type> &rhs) {
+  return !(lhs < rhs);
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Очередь многих производителей и одного потребителя (MPSC) по схеме Вьюкова.
+// Push выполняет один обмен хвоста и одну запись связи, без циклов CAS, и не
+// ждёт других потоков. Извлекать элементы может только один поток-потребитель:
+// TryPop по одному, PopBatch пачкой узлов без выделения памяти. WaitPopBatch засыпает
+// на условной переменной, если очередь пуста; производитель будит его, только
+// когда потребитель действительно ждёт. Элемент, вставка которого ещё не
+// завершена, потребитель увидит после того, как производитель запишет связь
+template <typename Type>
+class MpscSingleLinkedList {
+  // Первый узел цепочки — заглушка без значения. Извлечённый узел становится
+  // новой заглушкой, поэтому производители и потребитель не касаются одного
+  // и того же узла, пока в очереди есть хотя бы один элемент
+  struct Node {
+    std::atomic<Node *> next_node_{nullptr};
+    union {
+      Type value_;
+    };
+
+    Node() noexcept {}
+
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : value_(std::forward<Args>(args)...) {}
+
+    ~Node() {}
+  };
+
+ public:
+  // Извлечённые элементы в порядке вставки. Владеет узлами, отцепленными от
+  // очереди, и принадлежит потребителю
+  class Batch {
+    template <typename ValueType>
+    class BasicIterator {
+      friend class Batch;
+      Node *node_ = nullptr;
+      explicit BasicIterator(Node *node) noexcept : node_(node) {}
+
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = ValueType *;
+      using reference = ValueType &;
+
+      BasicIterator() = default;
+
+      BasicIterator(const BasicIterator<Type> &other) noexcept
+          : node_(other.node_) {}
+
+      BasicIterator &operator=(const BasicIterator &rhs) = default;
+
+      [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+        return node_ == rhs.node_;
+      }
+
+      [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+        return !(*this == rhs);
+      }
+
+      BasicIterator &operator++() noexcept {
+        assert(node_);
+        node_ = node_->next_node_.load(std::memory_order_relaxed);
+        return *this;
+      }
+
+      BasicIterator operator++(int) noexcept {
+        auto copy_(*this);
+        ++(*this);
+        return copy_;
+      }
+
+      [[nodiscard]] reference operator*() const noexcept {
+        assert(node_);
+        return node_->value_;
+      }
+
+      [[nodiscard]] pointer operator->() const noexcept {
+        assert(node_);
+        return &node_->value_;
+      }
+    };
+
+   public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    Batch() = default;
+
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
+
+    Batch(Batch &&other) noexcept
+        : head_(std::exchange(other.head_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    Batch &operator=(Batch &&rhs) noexcept {
+      if (this != &rhs) {
+        Batch temp_(std::move(rhs));
+        swap(temp_);
+      }
+      return *this;
+    }
+
+    ~Batch() {
+      while (head_ != nullptr) {
+        Node *next = head_->next_node_.load(std::memory_order_relaxed);
+        head_->value_.~Type();
+        delete head_;
+        head_ = next;
+      }
+    }
+
+    void swap(Batch &other) noexcept {
+      std::swap(head_, other.head_);
+      std::swap(size_, other.size_);
+    }
+
+    [[nodiscard]] Iterator begin() noexcept { return Iterator(head_); }
+
+    [[nodiscard]] Iterator end() noexcept { return Iterator(nullptr); }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+      return ConstIterator(head_);
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+      return ConstIterator(nullptr);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+   private:
+    friend class MpscSingleLinkedList;
+
+    Batch(Node *head, size_t size) noexcept : head_(head), size_(size) {}
+
+    Node *head_ = nullptr;
+    size_t size_ = 0;
+  };
+
+  // Число проверок очереди перед тем, как WaitPopBatch уснёт
+  static constexpr size_t kSpinCount = 64;
+
+  MpscSingleLinkedList() : head_(new Node()), tail_(head_) {}
+
+  MpscSingleLinkedList(const MpscSingleLinkedList &) = delete;
+  MpscSingleLinkedList &operator=(const MpscSingleLinkedList &) = delete;
+
+  // Вызывается, когда с объектом уже не работает ни один поток
+  ~MpscSingleLinkedList() {
+    Node *node = head_->next_node_.load(std::memory_order_acquire);
+    delete head_;
+    while (node != nullptr) {
+      Node *next = node->next_node_.load(std::memory_order_acquire);
+      node->value_.~Type();
+      delete node;
+      node = next;
+    }
+  }
+
+  void Push(const Type &value) { Emplace(value); }
+
+  void Push(Type &&value) { Emplace(std::move(value)); }
+
+  // Вызывается из любого числа потоков
+  template <typename... Args>
+  void Emplace(Args &&...args) {
+    Node *node = new Node(std::in_place, std::forward<Args>(args)...);
+    Node *previous = tail_.exchange(node, std::memory_order_acq_rel);
+    // Последовательно согласованные запись связи и чтение флага в паре с
+    // WaitPopBatchUntil: либо потребитель увидит новую связь, либо
+    // производитель увидит флаг ожидания
+    previous->next_node_.store(node, std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_seq_cst)) {
+      std::lock_guard lock(mutex_);
+      ready_.notify_one();
+    }
+  }
+
+  // Методы ниже вызываются только потребителем
+
+  [[nodiscard]] bool IsEmpty() const noexcept {
+    return head_->next_node_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  // Извлекает первый элемент или возвращает nullopt, если очередь пуста
+  [[nodiscard]] std::optional<Type> TryPop() {
+    Node *next = head_->next_node_.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<Type> result(std::move(next->value_));
+    Advance(next);
+    return result;
+  }
+
+  // Извлекает не больше max_count элементов в порядке вставки без выделения
+  // и освобождения памяти: узлы отцепляются от очереди и переходят в пачку.
+  // Последний извлечённый узел становится новой заглушкой, поэтому его
+  // значение перемещается в прежнюю заглушку, которая замыкает пачку. Если
+  // это перемещение бросило исключение, очередь не меняется
+  [[nodiscard]] Batch PopBatch(size_t max_count) {
+    Node *last = head_->next_node_.load(std::memory_order_acquire);
+    if (last == nullptr || max_count == 0) {
+      return Batch();
+    }
+    Node *before_last = nullptr;
+    size_t count = 1;
+    for (Node *next = last->next_node_.load(std::memory_order_acquire);
+         next != nullptr && count < max_count;
+         next = next->next_node_.load(std::memory_order_acquire), ++count) {
+      before_last = std::exchange(last, next);
+    }
+    Node *stub = head_;
+    ::new (static_cast<void *>(std::addressof(stub->value_)))
+        Type(std::move(last->value_));
+    // Отцепленные узлы уже не хвост очереди, производители их не изменяют
+    Node *first = stub;
+    if (before_last != nullptr) {
+      first = stub->next_node_.load(std::memory_order_relaxed);
+      before_last->next_node_.store(stub, std::memory_order_relaxed);
+    }
+    stub->next_node_.store(nullptr, std::memory_order_relaxed);
+    last->value_.~Type();
+    head_ = last;
+    return Batch(first, count);
+  }
+
+  // Как PopBatch, но ждёт появления хотя бы одного элемента
+  [[nodiscard]] Batch WaitPopBatch(size_t max_count) {
+    return WaitPopBatchUntil(max_count, std::nullopt);
+  }
+
+  // Как WaitPopBatch, но ждёт не дольше timeout и может вернуть пустой список
+  template <typename Rep, typename Period>
+  [[nodiscard]] Batch WaitPopBatchFor(
+      size_t max_count, std::chrono::duration<Rep, Period> timeout) {
+    return WaitPopBatchUntil(max_count, std::chrono::steady_clock::now() + timeout);
+  }
+
+ private:
+  // Уничтожает значение next и делает его заглушкой вместо прежней
+  void Advance(Node *next) noexcept {
+    next->value_.~Type();
+    delete std::exchange(head_, next);
+  }
+
+  Batch WaitPopBatchUntil(
+      size_t max_count,
+      std::optional<std::chrono::steady_clock::time_point> deadline) {
+    for (size_t spin = 0; spin < kSpinCount; ++spin) {
+      if (!IsEmpty()) {
+        return PopBatch(max_count);
+      }
+      std::this_thread::yield();
+    }
+    {
+      std::unique_lock lock(mutex_);
+      waiting_.store(true, std::memory_order_seq_cst);
+      const auto ready = [this] {
+        return head_->next_node_.load(std::memory_order_seq_cst) != nullptr;
+      };
+      if (deadline) {
+        ready_.wait_until(lock, *deadline, ready);
+      } else {
+        ready_.wait(lock, ready);
+      }
+      waiting_.store(false, std::memory_order_relaxed);
+    }
+    return PopBatch(max_count);
+  }
+
+  // Используется только потребителем
+  alignas(64) Node *head_;
+  // Общий для производителей
+  alignas(64) std::atomic<Node *> tail_;
+  alignas(64) std::atomic<bool> waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable ready_;
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Арена узлов: раздаёт память из непрерывных блоков и освобождает её целиком
+// за O(числа блоков). Освобождённые по одному узлы попадают в список
+// свободных слотов и переиспользуются. Не потокобезопасна.
+class NodePool {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+  static constexpr size_t kMaxBlockSize = 16 * 1024 * 1024;
+
+  explicit NodePool(size_t first_block_size = kDefaultBlockSize) noexcept
+      : next_block_size_(std::max(first_block_size, sizeof(Block) * 2)) {}
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  ~NodePool() { Release(); }
+
+  [[nodiscard]] void* Allocate(size_t bytes, size_t alignment) {
+    // Размер слота — наименьший запрошенный: блоки из нескольких узлов
+    // крупнее одиночного узла. Слоты прежнего размера больше не выдаются
+    if (slot_size_ == 0 || bytes < slot_size_) {
+      slot_size_ = bytes;
+      free_slots_ = nullptr;
+    }
+    if (bytes == slot_size_ && free_slots_ != nullptr) {
+      FreeSlot* slot = free_slots_;
+      free_slots_ = slot->next;
+      return slot;
+    }
+    void* result = TryBump(bytes, alignment);
+    if (result == nullptr) {
+      AddBlock(bytes + alignment);
+      result = TryBump(bytes, alignment);
+      assert(result != nullptr);
+    }
+    return result;
+  }
+
+  // Одиночные слоты размера slot_size_ возвращаются в список свободных,
+  // всё остальное (в том числе блоки из нескольких узлов) остаётся в блоке
+  // арены до вызова Release()
+  void Deallocate(void* ptr, size_t bytes) noexcept {
+    if (bytes < sizeof(FreeSlot)) {
+      return;
+    }
+    if (bytes == slot_size_) {
+      free_slots_ = ::new (ptr) FreeSlot{free_slots_};
+    }
+  }
+
+  // Освобождает все блоки разом. Все выданные указатели становятся недействительными
+  void Release() noexcept {
+    while (blocks_ != nullptr) {
+      Block* next = blocks_->next;
+      ::operator delete(static_cast<void*>(blocks_));
+      blocks_ = next;
+    }
+    cursor_ = limit_ = nullptr;
+    free_slots_ = nullptr;
+    slot_size_ = 0;
+    block_count_ = 0;
+    reserved_bytes_ = 0;
+  }
+
+  [[nodiscard]] size_t GetBlockCount() const noexcept { return block_count_; }
+
+  [[nodiscard]] size_t GetReservedBytes() const noexcept {
+    return reserved_bytes_;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  void* TryBump(size_t bytes, size_t alignment) noexcept {
+    if (cursor_ == nullptr) {
+      return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+    const auto available = reinterpret_cast<std::uintptr_t>(limit_);
+    if (aligned > available || available - aligned < bytes) {
+      return nullptr;
+    }
+    cursor_ = reinterpret_cast<std::byte*>(aligned + bytes);
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  void AddBlock(size_t min_payload) {
+    const size_t size = std::max(next_block_size_, min_payload + sizeof(Block));
+    auto* block = static_cast<Block*>(::operator new(size));
+    block->next = blocks_;
+    block->size = size;
+    blocks_ = block;
+    cursor_ = reinterpret_cast<std::byte*>(block + 1);
+    limit_ = reinterpret_cast<std::byte*>(block) + size;
+    ++block_count_;
+    reserved_bytes_ += size;
+    next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+  }
+
+  Block* blocks_ = nullptr;
+  std::byte* cursor_ = nullptr;
+  std::byte* limit_ = nullptr;
+  FreeSlot* free_slots_ = nullptr;
+  size_t slot_size_ = 0;
+  size_t next_block_size_;
+  size_t block_count_ = 0;
+  size_t reserved_bytes_ = 0;
+};
+
+// Аллокатор, совместимый с std::allocator, поверх разделяемой NodePool.
+// Копия списка получает собственную арену, поэтому список, единолично
+// владеющий ареной, освобождает все узлы за O(числа блоков)
+template <typename T>
+class NodePoolAllocator {
+  template <typename U>
+  friend class NodePoolAllocator;
+
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  NodePoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+
+  explicit NodePoolAllocator(std::shared_ptr<NodePool> pool) noexcept
+      : pool_(std::move(pool)) {
+    assert(pool_);
+  }
+
+  // Перемещение копирует аллокатор: перемещённый список остаётся пригодным
+  NodePoolAllocator(const NodePoolAllocator&) noexcept = default;
+  NodePoolAllocator& operator=(const NodePoolAllocator&) noexcept = default;
+
+  template <typename U>
+  NodePoolAllocator(const NodePoolAllocator<U>& other) noexcept
+      : pool_(other.pool_) {}
+
+  [[nodiscard]] T* allocate(size_t n) {
+    return static_cast<T*>(pool_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) noexcept {
+    pool_->Deallocate(ptr, n * sizeof(T));
+  }
+
+  [[nodiscard]] NodePoolAllocator select_on_container_copy_construction()
+      const {
+    return NodePoolAllocator();
+  }
+
+  // Арена принадлежит только этому аллокатору и может быть освобождена целиком
+  [[nodiscard]] bool IsExclusive() const noexcept {
+    return pool_.use_count() == 1;
+  }
+
+  void ReleaseAll() noexcept { pool_->Release(); }
+
+  [[nodiscard]] NodePool& GetPool() const noexcept { return *pool_; }
+
+  [[nodiscard]] size_t GetReservedBytes() const noexcept {
+    return pool_->GetReservedBytes();
+  }
+
+  template <typename U>
+  [[nodiscard]] bool operator==(const NodePoolAllocator<U>& rhs) const noexcept {
+    return pool_ == rhs.pool_;
+  }
+
+  template <typename U>
+  [[nodiscard]] bool operator!=(const NodePoolAllocator<U>& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+ private:
+  std::shared_ptr<NodePool> pool_;
+};
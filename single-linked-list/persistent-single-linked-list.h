@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Неизменяемый односвязный список со структурным разделением: узлы хранят
+// счётчик ссылок, поэтому копия списка разделяет с оригиналом все узлы и
+// создаётся за O(1). PushFront и PopFront меняют только голову своего
+// объекта и не затрагивают копии. Счётчики атомарны: копии можно передавать
+// в другие потоки и уничтожать там. Освобождение хвоста выполняется в цикле,
+// без рекурсии, при любой длине списка
+template <typename Type>
+class PersistentSingleLinkedList {
+  struct Node {
+    std::atomic<size_t> refs_{1};
+    Node *next_node_ = nullptr;
+    const Type value_;
+
+    template <typename... Args>
+    explicit Node(Node *next, Args &&...args)
+        : next_node_(next), value_(std::forward<Args>(args)...) {}
+  };
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class PersistentSingleLinkedList;
+    const Node *node_ = nullptr;
+    explicit BasicIterator(const Node *node) noexcept : node_(node) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(node_);
+      node_ = node_->next_node_;
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(node_);
+      return node_->value_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(node_);
+      return &node_->value_;
+    }
+  };
+
+ public:
+  // Элементы неизменяемы, поэтому оба итератора константные
+  using ConstIterator = BasicIterator<const Type>;
+  using Iterator = ConstIterator;
+
+  PersistentSingleLinkedList() = default;
+
+  PersistentSingleLinkedList(std::initializer_list<Type> values) {
+    AppendCopies(values.begin(), values.end());
+  }
+
+  template <typename InputIt,
+            typename = std::enable_if_t<std::is_convertible_v<
+                typename std::iterator_traits<InputIt>::iterator_category,
+                std::input_iterator_tag>>>
+  PersistentSingleLinkedList(InputIt first, InputIt last) {
+    AppendCopies(first, last);
+  }
+
+  // Разделяет все узлы other за O(1)
+  PersistentSingleLinkedList(const PersistentSingleLinkedList &other) noexcept
+      : head_(Acquire(other.head_)), size_(other.size_) {}
+
+  PersistentSingleLinkedList(PersistentSingleLinkedList &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  PersistentSingleLinkedList &operator=(
+      const PersistentSingleLinkedList &rhs) noexcept {
+    if (head_ != rhs.head_) {
+      Release(std::exchange(head_, Acquire(rhs.head_)));
+    }
+    size_ = rhs.size_;
+    return *this;
+  }
+
+  PersistentSingleLinkedList &operator=(
+      PersistentSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Release(std::exchange(head_, std::exchange(rhs.head_, nullptr)));
+      size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+  }
+
+  ~PersistentSingleLinkedList() { Release(head_); }
+
+  void swap(PersistentSingleLinkedList &other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] const Type &Front() const noexcept {
+    assert(!IsEmpty());
+    return head_->value_;
+  }
+
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  // Новый узел ссылается на прежнюю голову, которую продолжают видеть копии
+  template <typename... Args>
+  const Type &EmplaceFront(Args &&...args) {
+    head_ = new Node(head_, std::forward<Args>(args)...);
+    ++size_;
+    return head_->value_;
+  }
+
+  // Отпускает первый узел. Остальные узлы остаются общими с копиями
+  void PopFront() noexcept {
+    assert(!IsEmpty());
+    Node *node = head_;
+    head_ = Acquire(node->next_node_);
+    Release(node);
+    --size_;
+  }
+
+  void Clear() noexcept {
+    Release(std::exchange(head_, nullptr));
+    size_ = 0;
+  }
+
+  // Список с value в начале и всеми узлами текущего в качестве хвоста
+  [[nodiscard]] PersistentSingleLinkedList PushedFront(Type value) const {
+    PersistentSingleLinkedList result(*this);
+    result.PushFront(std::move(value));
+    return result;
+  }
+
+ private:
+  static Node *Acquire(Node *node) noexcept {
+    if (node != nullptr) {
+      node->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+  }
+
+  // Снимает ссылку с node и удаляет подряд все узлы, на которые больше
+  // никто не ссылается
+  static void Release(Node *node) noexcept {
+    while (node != nullptr &&
+           node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete std::exchange(node, node->next_node_);
+    }
+  }
+
+  template <typename I>
+  void AppendCopies(I begin_, I end_) {
+    Node **link = &head_;
+    try {
+      for (; begin_ != end_; ++begin_) {
+        *link = new Node(nullptr, *begin_);
+        link = &(*link)->next_node_;
+        ++size_;
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  Node *head_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename Type>
+void swap(PersistentSingleLinkedList<Type> &lhs,
+          PersistentSingleLinkedList<Type> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+// Списки с общими узлами сравниваются за O(1)
+template <typename Type>
+bool operator==(const PersistentSingleLinkedList<Type> &lhs,
+                const PersistentSingleLinkedList<Type> &rhs) {
+  return lhs.GetSize() == rhs.GetSize() &&
+         (lhs.begin() == rhs.begin() ||
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type>
+bool operator!=(const PersistentSingleLinkedList<Type> &lhs,
+                const PersistentSingleLinkedList<Type> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const PersistentSingleLinkedList<Type> &lhs,
+               const PersistentSingleLinkedList<Type> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type>
+bool operator<=(const PersistentSingleLinkedList<Type> &lhs,
+                const PersistentSingleLinkedList<Type> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const PersistentSingleLinkedList<Type> &lhs,
+               const PersistentSingleLinkedList<Type> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const PersistentSingleLinkedList<Type> &lhs,
+                const PersistentSingleLinkedList<Type> &rhs) {
+  return !(lhs < rhs);
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+// Односвязный список в стиле RCU: один поток-писатель и любое число читателей.
+// Читатели обходят список без блокировок внутри ReadGuard, который закрепляет
+// за ними текущую эпоху. Писатель публикует изменения связей release-записями,
+// а отцепленные узлы откладывает до окончания периода ожидания: узел, удалённый
+// в эпоху e, освобождается, когда глобальная эпоха достигает e + 2, то есть
+// когда завершились все чтения, которые могли его видеть. Эпоха продвигается,
+// только если все активные читатели уже в текущей эпохе
+template <typename Type>
+class RcuSingleLinkedList {
+  struct Node {
+    std::atomic<Node *> next_node_{nullptr};
+    // Связь в очереди узлов, ожидающих освобождения
+    Node *retired_next_ = nullptr;
+    uint64_t retired_epoch_ = 0;
+    const Type value_;
+
+    template <typename... Args>
+    explicit Node(Args &&...args) : value_(std::forward<Args>(args)...) {}
+  };
+
+  // Эпоха читателя или 0, если слот не закреплён
+  struct alignas(64) ReaderSlot {
+    std::atomic<bool> owned_{false};
+    std::atomic<uint64_t> epoch_{0};
+  };
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class RcuSingleLinkedList;
+    const Node *node_ = nullptr;
+    explicit BasicIterator(const Node *node) noexcept : node_(node) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(node_);
+      node_ = node_->next_node_.load(std::memory_order_acquire);
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(node_);
+      return node_->value_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(node_);
+      return &node_->value_;
+    }
+  };
+
+ public:
+  // Элементы опубликованы читателям и не изменяются, поэтому оба итератора
+  // константные
+  using ConstIterator = BasicIterator<const Type>;
+  using Iterator = ConstIterator;
+
+  static constexpr size_t kMaxReaderSlots = 128;
+
+  // Критическая секция чтения. Итераторы действительны, пока жив объект.
+  // Один поток может держать несколько секций одновременно
+  class ReadGuard {
+   public:
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+    ~ReadGuard() {
+      slot_.epoch_.store(0, std::memory_order_release);
+      slot_.owned_.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+      return ConstIterator(list_.head_.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+      return ConstIterator(nullptr);
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return begin() == end(); }
+
+   private:
+    friend class RcuSingleLinkedList;
+
+    explicit ReadGuard(const RcuSingleLinkedList &list) noexcept
+        : list_(list), slot_(list.AcquireSlot()) {
+      // Повтор нужен, если писатель продвинул эпоху между чтением и записью
+      uint64_t epoch = list_.epoch_.load();
+      while (true) {
+        slot_.epoch_.store(epoch);
+        const uint64_t current = list_.epoch_.load();
+        if (current == epoch) {
+          break;
+        }
+        epoch = current;
+      }
+    }
+
+    const RcuSingleLinkedList &list_;
+    ReaderSlot &slot_;
+  };
+
+  RcuSingleLinkedList() = default;
+
+  RcuSingleLinkedList(const RcuSingleLinkedList &) = delete;
+  RcuSingleLinkedList &operator=(const RcuSingleLinkedList &) = delete;
+
+  // Вызывается, когда с объектом уже не работает ни один поток
+  ~RcuSingleLinkedList() {
+    for (Node *node = head_.load(std::memory_order_acquire); node != nullptr;) {
+      delete std::exchange(node, node->next_node_.load(std::memory_order_relaxed));
+    }
+    FreeRetired(retired_head_);
+  }
+
+  // Начинает чтение. Вызывается из любого потока
+  [[nodiscard]] ReadGuard Read() const noexcept { return ReadGuard(*this); }
+
+  // Приблизительный размер: при чтении во время изменений может устареть
+  [[nodiscard]] size_t GetSize() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  // Методы ниже вызываются только потоком-писателем
+
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  // Узел полностью создаётся до публикации, поэтому читатели видят его
+  // готовым
+  template <typename... Args>
+  void EmplaceFront(Args &&...args) {
+    Node *node = new Node(std::forward<Args>(args)...);
+    node->next_node_.store(head_.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    head_.store(node, std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void PopFront() {
+    Node *node = head_.load(std::memory_order_relaxed);
+    assert(node != nullptr);
+    head_.store(node->next_node_.load(std::memory_order_relaxed),
+                std::memory_order_release);
+    Retire(node);
+  }
+
+  // Отцепляет элемент, следующий за pos. Читатели, стоящие на нём, продолжают
+  // обход по его прежней связи. pos получают внутри ReadGuard
+  void EraseAfter(ConstIterator pos) {
+    assert(pos.node_ != nullptr);
+    auto &link = const_cast<Node *>(pos.node_)->next_node_;
+    Node *node = link.load(std::memory_order_relaxed);
+    assert(node != nullptr);
+    link.store(node->next_node_.load(std::memory_order_relaxed),
+               std::memory_order_release);
+    Retire(node);
+  }
+
+  void Clear() {
+    Node *node = head_.load(std::memory_order_relaxed);
+    head_.store(nullptr, std::memory_order_release);
+    while (node != nullptr) {
+      Node *next = node->next_node_.load(std::memory_order_relaxed);
+      Retire(node);
+      node = next;
+    }
+  }
+
+  // Ждёт завершения чтений, начатых до вызова, и освобождает все отложенные
+  // узлы. Писатель не должен держать ReadGuard во время вызова
+  void Synchronize() {
+    while (retired_head_ != nullptr) {
+      if (!TryAdvanceEpoch()) {
+        std::this_thread::yield();
+      }
+      Reclaim();
+    }
+  }
+
+  // Число отцепленных узлов, ожидающих освобождения
+  [[nodiscard]] size_t GetRetiredCount() const noexcept { return retired_count_; }
+
+ private:
+  // Порог числа отложенных узлов, после которого писатель пробует продвинуть эпоху
+  static constexpr size_t kReclaimThreshold = 64;
+
+  ReaderSlot &AcquireSlot() const noexcept {
+    static thread_local const size_t hint =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (size_t attempt = 0;; ++attempt) {
+      ReaderSlot &slot = readers_[(hint + attempt) % kMaxReaderSlots];
+      if (!slot.owned_.load(std::memory_order_relaxed) &&
+          !slot.owned_.exchange(true, std::memory_order_acquire)) {
+        return slot;
+      }
+      if (attempt % kMaxReaderSlots == kMaxReaderSlots - 1) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Ставит отцепленный узел в очередь с текущей эпохой
+  void Retire(Node *node) {
+    node->retired_epoch_ = epoch_.load(std::memory_order_relaxed);
+    node->retired_next_ = nullptr;
+    (retired_tail_ != nullptr ? retired_tail_->retired_next_ : retired_head_) = node;
+    retired_tail_ = node;
+    ++retired_count_;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    if (retired_count_ >= kReclaimThreshold) {
+      TryAdvanceEpoch();
+      Reclaim();
+    }
+  }
+
+  // Продвигает эпоху, если ни один читатель не закреплён в предыдущей
+  bool TryAdvanceEpoch() noexcept {
+    const uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+    for (const ReaderSlot &slot : readers_) {
+      const uint64_t reader_epoch = slot.epoch_.load();
+      if (reader_epoch != 0 && reader_epoch != epoch) {
+        return false;
+      }
+    }
+    epoch_.store(epoch + 1);
+    return true;
+  }
+
+  // Освобождает узлы, период ожидания которых истёк. Очередь упорядочена по эпохам
+  void Reclaim() noexcept {
+    const uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+    while (retired_head_ != nullptr && retired_head_->retired_epoch_ + 2 <= epoch) {
+      delete std::exchange(retired_head_, retired_head_->retired_next_);
+      --retired_count_;
+    }
+    if (retired_head_ == nullptr) {
+      retired_tail_ = nullptr;
+    }
+  }
+
+  static void FreeRetired(Node *node) noexcept {
+    while (node != nullptr) {
+      delete std::exchange(node, node->retired_next_);
+    }
+  }
+
+  alignas(64) std::atomic<Node *> head_{nullptr};
+  std::atomic<size_t> size_{0};
+  alignas(64) std::atomic<uint64_t> epoch_{1};
+  // Очередь отложенных узлов принадлежит писателю
+  Node *retired_head_ = nullptr;
+  Node *retired_tail_ = nullptr;
+  size_t retired_count_ = 0;
+  mutable std::array<ReaderSlot, kMaxReaderSlots> readers_;
+};
@@ -1,32 +1,174 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
-template <typename Type>
+#include "background-reclaimer.h"
+#include "list-instrumentation.h"
+#include "thread-pool.h"
+
+namespace detail {
+
+// Аллокатор умеет освобождать все выданные узлы разом (см. NodePoolAllocator)
+template <typename Alloc, typename = void>
+struct HasBulkRelease : std::false_type {};
+
+template <typename Alloc>
+struct HasBulkRelease<
+    Alloc, std::void_t<decltype(std::declval<const Alloc&>().IsExclusive()),
+                       decltype(std::declval<Alloc&>().ReleaseAll())>>
+    : std::true_type {};
+
+// Аллокатор сообщает, сколько памяти он удерживает
+template <typename Alloc, typename = void>
+struct HasReservedBytes : std::false_type {};
+
+template <typename Alloc>
+struct HasReservedBytes<
+    Alloc, std::void_t<decltype(std::declval<const Alloc&>().GetReservedBytes())>>
+    : std::true_type {};
+
+template <typename I>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<I>::iterator_category, std::input_iterator_tag>>;
+
+template <typename I, typename = void>
+struct IteratorConcept {
+  using type = typename std::iterator_traits<I>::iterator_category;
+};
+
+template <typename I>
+struct IteratorConcept<I, std::void_t<typename I::iterator_concept>> {
+  using type = typename I::iterator_concept;
+};
+
+// Итераторы, разыменование которых возвращает временное значение, объявляют
+// категорию ввода, но многопроходность заявляют через iterator_concept
+template <typename I>
+inline constexpr bool kIsForwardIterator = std::is_convertible_v<
+    typename IteratorConcept<I>::type, std::forward_iterator_tag>;
+
+// Ссылка итератора на статистику списка. При выключенной инструментации пуста
+template <typename Instrumentation, bool = Instrumentation::kEnabled>
+class IteratorProbe {
+ public:
+  IteratorProbe() = default;
+  explicit IteratorProbe(Instrumentation *) noexcept {}
+  void OnIncrement() const noexcept {}
+};
+
+template <typename Instrumentation>
+class IteratorProbe<Instrumentation, true> {
+ public:
+  IteratorProbe() = default;
+  explicit IteratorProbe(Instrumentation *instrumentation) noexcept
+      : instrumentation_(instrumentation) {}
+  void OnIncrement() const noexcept {
+    if (instrumentation_ != nullptr) {
+      instrumentation_->OnIncrement();
+    }
+  }
+
+ private:
+  Instrumentation *instrumentation_ = nullptr;
+};
+
+// Подсказка процессору загрузить строку кэша заранее
+inline void Prefetch(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  (void)address;
+#endif
+}
+
+// Размер страницы, по которому оценивается разброс узлов в памяти
+inline constexpr size_t kPageSize = 4096;
+
+}  // namespace detail
+
+// Результат SingleLinkedList::Compact. Обращения к страницам считаются как
+// число смен страницы памяти при обходе списка от начала до конца
+struct CompactionReport {
+  size_t bytes_before = 0;
+  size_t bytes_after = 0;
+  size_t page_visits_before = 0;
+  size_t page_visits_after = 0;
+
+  [[nodiscard]] size_t GetReclaimedBytes() const noexcept {
+    return bytes_before > bytes_after ? bytes_before - bytes_after : 0;
+  }
+
+  [[nodiscard]] size_t GetReclaimedPages() const noexcept {
+    return GetReclaimedBytes() / detail::kPageSize;
+  }
+};
+
+// Instrumentation — политика учёта памяти и времени операций
+// (см. list-instrumentation.h). NoListInstrumentation не добавляет ни кода, ни данных
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename Instrumentation = NoListInstrumentation>
 class SingleLinkedList {
-  struct Node {
-    Type value_;
+  struct Node;
+
+  // Фиктивный узел перед первым элементом не хранит значения, поэтому
+  // Type не обязан иметь конструктор по умолчанию
+  struct NodeBase {
     Node *next_node_ = nullptr;
-    Node() = default;
-    Node(const Type &value, Node *node) : value_(value), next_node_(node) {}
+    NodeBase() = default;
+    explicit NodeBase(Node *node) noexcept : next_node_(node) {}
     explicit operator bool() const noexcept { return next_node_ != nullptr; }
   };
 
+  struct Node : NodeBase {
+    Type value_;
+    // Значение конструируется прямо внутри узла из переданных аргументов
+    template <typename... Args>
+    explicit Node(Node *node, Args &&...args)
+        : NodeBase(node), value_(std::forward<Args>(args)...) {}
+  };
+
+  // Память уничтоженного узла в списке свободных хранит только связь
+  struct FreeNode {
+    Node *next_;
+  };
+  static_assert(sizeof(FreeNode) <= sizeof(Node) &&
+                alignof(FreeNode) <= alignof(Node));
+
+  using Probe = detail::IteratorProbe<Instrumentation>;
+
   template <typename ValueType>
   class BasicIterator {
     friend class SingleLinkedList;
-    Node *node_ = nullptr;
-    explicit BasicIterator(Node *node) : node_(node) {}
+    // Указывает на NodeBase, чтобы before_begin() мог ссылаться на head_
+    NodeBase *node_ = nullptr;
+    [[no_unique_address]] Probe probe_;
+    explicit BasicIterator(NodeBase *node, Probe probe = Probe())
+        : node_(node), probe_(probe) {}
 
    public:
     using iterator_category = std::forward_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
     using value_type = Type;
     using difference_type = std::ptrdiff_t;
     using pointer = ValueType *;
@@ -37,7 +179,7 @@ class SingleLinkedList {
     BasicIterator &operator=(const BasicIterator &rhs) = default;
 
     BasicIterator(const BasicIterator<Type> &other) noexcept
-    : node_(other.node_)
+    : node_(other.node_), probe_(other.probe_)
     {}
 
     [[nodiscard]] bool operator==(
@@ -61,6 +203,7 @@ class SingleLinkedList {
 
     BasicIterator &operator++() noexcept {
       assert(node_);
+      probe_.OnIncrement();
       node_ = node_->next_node_;
       return *this;
     }
@@ -74,66 +217,789 @@ class SingleLinkedList {
 
     [[nodiscard]] reference operator*() const noexcept {
       assert(node_);
-      return node_->value_;
+      return static_cast<Node *>(node_)->value_;
     }
     [[nodiscard]] pointer operator->() const noexcept {
       assert(node_);
-      return &node_->value_;
+      return &static_cast<Node *>(node_)->value_;
     }
   };
 
  private:
-  Node head_;
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  static constexpr bool kBulkRelease = detail::HasBulkRelease<NodeAllocator>::value;
+  // Минимальная длина сегмента, который сортируется в отдельной задаче пула
+  static constexpr size_t kMinParallelSortSegment = 1024;
+  // Параллельные ForEach/Transform/Reduce делят список не более чем на
+  // kMaxParallelSegments сегментов длиной от kMinParallelSortSegment узлов.
+  // Разбиение зависит только от размера списка, а не от числа потоков
+  static constexpr size_t kMaxParallelSegments = 256;
+  // Compact перемещает значения, только если перемещение и обратное
+  // перемещение не бросают исключений, иначе копирует
+  static constexpr bool kRelocateByMove =
+      std::is_nothrow_move_constructible_v<Type> &&
+      std::is_nothrow_move_assignable_v<Type>;
+
+ public:
+  // На сколько узлов вперёд алгоритмы обхода запрашивают узлы. Подобрано для
+  // узлов размером в одну-две строки кэша
+  static constexpr size_t kDefaultPrefetchDistance = 4;
+  // Во сколько раз обход может затрагивать больше страниц, чем занимают узлы
+  // при плотной укладке, прежде чем CompactIfFragmented выполнит сжатие
+  static constexpr double kDefaultFragmentationThreshold = 4.0;
+  static constexpr size_t kDefaultIndexStride = 64;
+
+ private:
+
+  NodeBase head_;
+  // Последний узел списка, nullptr у пустого списка
+  Node *tail_ = nullptr;
   size_t size_ = 0;
+  NodeAllocator alloc_;
+  [[no_unique_address]] mutable Instrumentation instrumentation_;
+  // Если задан, Clear и деструктор отдают цепочку узлов этому потоку
+  BackgroundReclaimer *reclaimer_ = nullptr;
+  // Память узлов, сохранённая для повторного использования. Пока
+  // size_ + free_count_ не меньше reserved_, вставки не обращаются к аллокатору
+  Node *free_nodes_ = nullptr;
+  size_t free_count_ = 0;
+  size_t reserved_ = 0;
+
+  // Позиционный индекс: узлы, расстояние которых до последнего узла кратно
+  // stride_. Эти расстояния не меняются при вставке и удалении в начале,
+  // поэтому PushFront и PopFront поддерживают индекс за O(1), а остальные
+  // изменения помечают его устаревшим до следующего обращения
+  struct PositionalIndex {
+    size_t stride_;
+    // entries_[j] — узел на расстоянии j * stride_ от последнего узла
+    std::vector<Node *> entries_;
+    // Номер j для каждого узла из entries_
+    std::unordered_map<const NodeBase *, size_t> entry_of_;
+    bool valid_ = false;
+  };
+  // Настройка принадлежит объекту списка, как и reclaimer_
+  std::unique_ptr<PositionalIndex> index_;
+
+  [[nodiscard]] Probe GetProbe() const noexcept {
+    return Probe(&instrumentation_);
+  }
+
+  template <typename... Args>
+  Node* CreateNode(Node *next, Args &&...args) {
+    Node *node = free_nodes_ != nullptr ? TakeFreeNode()
+                                        : NodeTraits::allocate(alloc_, 1);
+    try {
+      NodeTraits::construct(alloc_, node, next, std::forward<Args>(args)...);
+    } catch (...) {
+      ReleaseNodeMemory(node);
+      throw;
+    }
+    instrumentation_.OnAllocate(1);
+    return node;
+  }
+
+  void StealNodes(SingleLinkedList &other) noexcept {
+    InvalidateIndex();
+    other.InvalidateIndex();
+    head_.next_node_ = std::exchange(other.head_.next_node_, nullptr);
+    tail_ = std::exchange(other.tail_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  static void DestroyChain(NodeAllocator &alloc, Node *node) noexcept {
+    while (node != nullptr) {
+      Node *next = node->next_node_;
+      NodeTraits::destroy(alloc, node);
+      NodeTraits::deallocate(alloc, node, 1);
+      node = next;
+    }
+  }
+
+  void DestroyNode(Node *node) noexcept {
+    NodeTraits::destroy(alloc_, node);
+    ReleaseNodeMemory(node);
+    instrumentation_.OnDeallocate(1);
+  }
+
+  [[nodiscard]] Node *TakeFreeNode() noexcept {
+    assert(free_nodes_ != nullptr);
+    Node *node = free_nodes_;
+    free_nodes_ = std::launder(reinterpret_cast<FreeNode *>(node))->next_;
+    --free_count_;
+    return node;
+  }
+
+  // Сохраняет память узла в списке свободных, пока их меньше reserved_,
+  // иначе возвращает её аллокатору
+  void ReleaseNodeMemory(Node *node) noexcept {
+    if (free_count_ < reserved_) {
+      ::new (static_cast<void *>(node)) FreeNode{free_nodes_};
+      free_nodes_ = node;
+      ++free_count_;
+    } else {
+      NodeTraits::deallocate(alloc_, node, 1);
+    }
+  }
+
+  // Освобождает сохранённую память узлов, не меняя reserved_
+  void ReleaseFreeNodes() noexcept {
+    while (free_nodes_ != nullptr) {
+      NodeTraits::deallocate(alloc_, TakeFreeNode(), 1);
+    }
+  }
 
+  // Обменивает сохранённую память узлов и резерв со списком с тем же аллокатором
+  void SwapFreeNodes(SingleLinkedList &other) noexcept {
+    std::swap(free_nodes_, other.free_nodes_);
+    std::swap(free_count_, other.free_count_);
+    std::swap(reserved_, other.reserved_);
+  }
+
+  // Строит копии [begin_, end_) во временном списке, беря узлы из списка
+  // свободных. Если построение не удалось, узлы возвращаются в него
   template <typename I>
-  void reassign(I begin_, I end_) {
-    SingleLinkedList<Type> temp_;
-    Node* curr_ = &temp_.head_;
+  SingleLinkedList BuildChain(I begin_, I end_) {
+    SingleLinkedList temp_(GetAllocator());
+    temp_.SwapFreeNodes(*this);
+    try {
+      temp_.AppendRange(&temp_.head_, begin_, end_);
+    } catch (...) {
+      temp_.EraseChainAfter(&temp_.head_);
+      SwapFreeNodes(temp_);
+      throw;
+    }
+    SwapFreeNodes(temp_);
+    return temp_;
+  }
+
+  // Дописывает копии [begin_, end_) после последнего узла tail и возвращает
+  // новый последний узел. Если число элементов известно заранее и список
+  // свободных пуст, арена выделяет все узлы одним блоком
+  template <typename I>
+  NodeBase* AppendRange(NodeBase* tail, I begin_, I end_) {
+    assert(tail->next_node_ == nullptr);
+    InvalidateIndex();
+    if constexpr (kBulkRelease && detail::kIsForwardIterator<I>) {
+      if (free_nodes_ == nullptr) {
+        return AppendBlock(tail, begin_, end_);
+      }
+    }
     while (begin_ != end_) {
-      Node* next_node = new Node(*begin_, nullptr);
-      curr_->next_node_ = next_node;
-      curr_ = curr_->next_node_;
+      tail->next_node_ = CreateNode(nullptr, *begin_);
+      tail = tail_ = tail->next_node_;
       ++begin_;
-      ++temp_.size_;
+      ++size_;
+    }
+    return tail;
+  }
+
+  // Выделяет узлы для копий [begin_, end_) одним блоком арены
+  template <typename I>
+  NodeBase* AppendBlock(NodeBase* tail, I begin_, I end_) {
+    const auto count = static_cast<size_t>(std::distance(begin_, end_));
+    if (count == 0) {
+      return tail;
+    }
+    Node* block = NodeTraits::allocate(alloc_, count);
+    size_t built = 0;
+    try {
+      for (; built < count; ++built, ++begin_) {
+        NodeTraits::construct(alloc_, block + built, nullptr, *begin_);
+      }
+    } catch (...) {
+      while (built > 0) {
+        NodeTraits::destroy(alloc_, block + --built);
+      }
+      NodeTraits::deallocate(alloc_, block, count);
+      throw;
+    }
+    for (size_t i = 0; i + 1 < count; ++i) {
+      block[i].next_node_ = block + i + 1;
+    }
+    instrumentation_.OnAllocate(count);
+    tail->next_node_ = block;
+    size_ += count;
+    tail_ = block + count - 1;
+    return tail_;
+  }
+
+  // Удаляет все узлы после pos, pos становится последним узлом
+  void EraseChainAfter(NodeBase* pos) noexcept {
+    InvalidateIndex();
+    while (*pos) {
+      DestroyNode(std::exchange(pos->next_node_, pos->next_node_->next_node_));
+      --size_;
+    }
+    tail_ = AsNode(pos);
+  }
+
+  // Узел по адресу базы или nullptr для фиктивного узла head_
+  [[nodiscard]] Node* AsNode(NodeBase* base) noexcept {
+    return base == &head_ ? nullptr : static_cast<Node*>(base);
+  }
+
+  [[nodiscard]] NodeBase* GetTail() noexcept {
+    return tail_ != nullptr ? static_cast<NodeBase*>(tail_) : &head_;
+  }
+
+  // Находит последний узел после перестановки узлов
+  void RestoreTail() noexcept {
+    NodeBase* tail = &head_;
+    while (*tail) {
+      tail = tail->next_node_;
+    }
+    tail_ = AsNode(tail);
+  }
+
+  // Переносит за O(1) узлы (before, last] списка other в позицию после pos
+  void SpliceRangeAfter(NodeBase* pos, SingleLinkedList& other,
+                        NodeBase* before, Node* last, size_t count) noexcept {
+    assert(alloc_ == other.alloc_);
+    InvalidateIndex();
+    other.InvalidateIndex();
+    Node* first = before->next_node_;
+    before->next_node_ = last->next_node_;
+    if (other.tail_ == last) {
+      other.tail_ = other.AsNode(before);
+    }
+    other.size_ -= count;
+
+    last->next_node_ = pos->next_node_;
+    pos->next_node_ = first;
+    if (last->next_node_ == nullptr) {
+      tail_ = last;
+    }
+    size_ += count;
+  }
+
+  void InvalidateIndex() noexcept {
+    if (index_) {
+      index_->valid_ = false;
+    }
+  }
+
+  // Новый первый узел попадает в индекс, если его расстояние до последнего
+  // узла кратно шагу. Нехватка памяти только помечает индекс устаревшим
+  void IndexPushedFront() noexcept {
+    if (index_ && index_->valid_ && (size_ - 1) % index_->stride_ == 0) {
+      try {
+        index_->entries_.push_back(head_.next_node_);
+        index_->entry_of_.emplace(head_.next_node_, index_->entries_.size() - 1);
+      } catch (...) {
+        index_->valid_ = false;
+      }
+    }
+  }
+
+  // Вызывается перед удалением первого узла
+  void IndexPoppingFront() noexcept {
+    if (index_ && index_->valid_ && (size_ - 1) % index_->stride_ == 0) {
+      assert(index_->entries_.back() == head_.next_node_);
+      index_->entries_.pop_back();
+      index_->entry_of_.erase(head_.next_node_);
+    }
+  }
+
+  // Индекс, перестроенный при необходимости за O(n), или nullptr.
+  // Перестраивается только в неконстантных методах, чтобы одновременные
+  // вызовы константных методов не изменяли список
+  const PositionalIndex *GetValidIndex() {
+    if (!index_) {
+      return nullptr;
+    }
+    if (!index_->valid_) {
+      const size_t stride = index_->stride_;
+      auto &entries = index_->entries_;
+      auto &entry_of = index_->entry_of_;
+      entries.assign(size_ == 0 ? 0 : (size_ - 1) / stride + 1, nullptr);
+      entry_of.clear();
+      entry_of.reserve(entries.size());
+      size_t distance = size_;
+      for (Node *node = head_.next_node_; node != nullptr; node = node->next_node_) {
+        if (--distance % stride == 0) {
+          entries[distance / stride] = node;
+          entry_of.emplace(node, distance / stride);
+        }
+      }
+      index_->valid_ = true;
+    }
+    return index_.get();
+  }
+
+  // Актуальный индекс или nullptr, если его нет или он устарел
+  const PositionalIndex *FindValidIndex() const noexcept {
+    return index_ && index_->valid_ ? index_.get() : nullptr;
+  }
+
+  // Узел в позиции position из [0, size_]; для size_ возвращается nullptr.
+  // Без индекса узел ищется обходом от начала
+  Node *NodeAt(size_t position, const PositionalIndex *index) const {
+    assert(position <= size_);
+    if (position == size_) {
+      return nullptr;
+    }
+    Node *node = head_.next_node_;
+    size_t steps = position;
+    if (index != nullptr) {
+      // Ближайший узел индекса не дальше position от начала
+      const size_t distance = size_ - 1 - position;
+      const size_t entry = (distance + index->stride_ - 1) / index->stride_;
+      if (entry < index->entries_.size()) {
+        node = index->entries_[entry];
+        steps = entry * index->stride_ - distance;
+      }
+    }
+    for (; steps > 0; --steps) {
+      node = node->next_node_;
+    }
+    return node;
+  }
+
+  // Сдвигает node на n узлов. С индексом позиция node определяется по
+  // ближайшему следующему узлу индекса: до него меньше stride_ шагов, поэтому
+  // индекс используется, только когда n больше 2 * stride_
+  NodeBase *AdvanceNode(NodeBase *node, size_t n,
+                        const PositionalIndex *index) const {
+    if (index != nullptr && node == &head_) {
+      assert(n <= size_ + 1);
+      return n == 0 ? node : NodeAt(n - 1, index);
+    }
+    if (index != nullptr && node != nullptr && n > 2 * index->stride_) {
+      const NodeBase *current = node;
+      for (size_t offset = 0; offset < index->stride_ && current != nullptr;
+           ++offset) {
+        const auto it = index->entry_of_.find(current);
+        if (it != index->entry_of_.end()) {
+          const size_t position = size_ - 1 - it->second * index->stride_ - offset;
+          assert(position + n <= size_);
+          return NodeAt(position + n, index);
+        }
+        current = current->next_node_;
+      }
+    }
+    for (; n > 0; --n) {
+      assert(node != nullptr);
+      node = node->next_node_;
+    }
+    return node;
+  }
+
+  size_t CheckPosition(size_t position) const {
+    if (position >= size_) {
+      throw std::out_of_range("SingleLinkedList position out of range");
+    }
+    return position;
+  }
+
+  static decltype(auto) Relocated(Type &value) noexcept {
+    if constexpr (kRelocateByMove) {
+      return std::move(value);
+    } else {
+      return std::as_const(value);
+    }
+  }
+
+  // Строит в памяти target новые узлы со значениями списка в порядке обхода:
+  // в заранее выделенном блоке block на size_ узлов или, если block пуст,
+  // поштучно. Возвращает первый новый узел, старые узлы не изменяются
+  // (кроме перемещённых значений). Последний новый узел записывается в last,
+  // для пустого списка оба результата nullptr. При исключении значения
+  // возвращаются на место, а новые узлы освобождаются
+  Node *RelocateChain(NodeAllocator &target, Node *block, Node *&last) {
+    last = nullptr;
+    if (head_.next_node_ == nullptr) {
+      return nullptr;
+    }
+    NodeBase fresh;
+    NodeBase *tail = &fresh;
+    Node *built_last = nullptr;
+    size_t built = 0;
+    try {
+      for (Node *old = head_.next_node_; old != nullptr;
+           old = old->next_node_, ++built) {
+        Node *node = block != nullptr ? block + built
+                                      : NodeTraits::allocate(target, 1);
+        try {
+          NodeTraits::construct(target, node, nullptr, Relocated(old->value_));
+        } catch (...) {
+          if (block == nullptr) {
+            NodeTraits::deallocate(target, node, 1);
+          }
+          throw;
+        }
+        tail->next_node_ = node;
+        tail = node;
+        built_last = node;
+      }
+    } catch (...) {
+      Node *old = head_.next_node_;
+      for (Node *node = fresh.next_node_; node != nullptr; old = old->next_node_) {
+        if constexpr (kRelocateByMove) {
+          old->value_ = std::move(node->value_);
+        }
+        Node *next = node->next_node_;
+        NodeTraits::destroy(target, node);
+        if (block == nullptr) {
+          NodeTraits::deallocate(target, node, 1);
+        }
+        node = next;
+      }
+      if (block != nullptr) {
+        NodeTraits::deallocate(target, block, size_);
+      }
+      throw;
+    }
+    last = built_last;
+    return fresh.next_node_;
+  }
+
+  // Число смен страницы памяти при обходе списка
+  [[nodiscard]] size_t CountPageVisits() const noexcept {
+    size_t visits = 0;
+    std::uintptr_t page = 0;
+    for (const Node *node = head_.next_node_; node != nullptr;
+         node = node->next_node_) {
+      const auto current = reinterpret_cast<std::uintptr_t>(node) / detail::kPageSize;
+      if (visits == 0 || current != page) {
+        page = current;
+        ++visits;
+      }
+    }
+    return visits;
+  }
+
+  template <typename I>
+  void reassign(I begin_, I end_) {
+    SingleLinkedList temp_ = BuildChain(begin_, end_);
+    instrumentation_.OnAllocate(temp_.size_);
+    EraseChainAfter(&head_);
+    StealNodes(temp_);
+  }
+
+  // Дописывает цепочку chain после tail и сдвигает tail на её последний узел
+  static void AppendChain(NodeBase *&tail, Node *chain) noexcept {
+    tail->next_node_ = chain;
+    while (tail->next_node_ != nullptr) {
+      tail = tail->next_node_;
+    }
+  }
+
+  // Устойчиво сливает отсортированные цепочки first и second в first.
+  // Если comp выбрасывает исключение, в first остаются все узлы обеих цепочек
+  template <typename Compare>
+  static void MergeChains(Node *&first, Node *second, Compare &comp) {
+    NodeBase merged;
+    NodeBase *tail = &merged;
+    Node *left = first;
+    try {
+      while (left != nullptr && second != nullptr) {
+        if (comp(second->value_, left->value_)) {
+          tail->next_node_ = second;
+          second = second->next_node_;
+        } else {
+          tail->next_node_ = left;
+          left = left->next_node_;
+        }
+        tail = tail->next_node_;
+      }
+    } catch (...) {
+      AppendChain(tail, left);
+      tail->next_node_ = second;
+      first = merged.next_node_;
+      throw;
+    }
+    tail->next_node_ = left != nullptr ? left : second;
+    first = merged.next_node_;
+  }
+
+  // Обходит узлы начиная с node, пока visit возвращает true. Опережающий
+  // указатель идёт на PrefetchDistance узлов впереди и заранее запрашивает
+  // следующий за собой узел, так что к моменту обработки узел уже в кэше.
+  // Возвращает узел, на котором обход остановлен, или nullptr
+  template <size_t PrefetchDistance, typename Visitor>
+  static Node *WalkWithPrefetch(Node *node, Visitor &visit) {
+    Node *ahead = node;
+    for (size_t i = 0; i < PrefetchDistance && ahead != nullptr; ++i) {
+      ahead = ahead->next_node_;
+    }
+    while (node != nullptr) {
+      if (ahead != nullptr) {
+        ahead = ahead->next_node_;
+        detail::Prefetch(ahead);
+      }
+      if (!visit(node)) {
+        return node;
+      }
+      node = node->next_node_;
+    }
+    return nullptr;
+  }
+
+  // Вызывает process(index, first, length) для каждого сегмента списка.
+  // Потоки пула забирают сегменты по очереди, поэтому неравномерная по
+  // времени обработка узлов не оставляет потоки без работы. Первое
+  // исключение пробрасывается после завершения всех потоков
+  template <typename Process>
+  void RunSegments(ThreadPool &pool, Process &process) const {
+    if (size_ == 0) {
+      return;
+    }
+    const size_t segment_length =
+        std::max(kMinParallelSortSegment,
+                 (size_ + kMaxParallelSegments - 1) / kMaxParallelSegments);
+    const size_t segment_count = (size_ + segment_length - 1) / segment_length;
+    const auto length_of = [&](size_t index) {
+      return std::min(segment_length, size_ - index * segment_length);
+    };
+
+    std::vector<Node *> starts(segment_count);
+    Node *node = head_.next_node_;
+    for (size_t i = 0; i < segment_count; ++i) {
+      starts[i] = node;
+      for (size_t j = 0; j < segment_length && node != nullptr; ++j) {
+        node = node->next_node_;
+      }
+    }
+
+    const size_t worker_count = std::min(pool.GetThreadCount(), segment_count);
+    if (worker_count < 2) {
+      for (size_t i = 0; i < segment_count; ++i) {
+        process(i, starts[i], length_of(i));
+      }
+      return;
+    }
+
+    std::atomic<size_t> next_segment{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto work = [&] {
+      for (size_t i = next_segment++; i < segment_count && !failed;
+           i = next_segment++) {
+        try {
+          process(i, starts[i], length_of(i));
+        } catch (...) {
+          std::lock_guard lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+      }
+    };
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      tasks.push_back(pool.Submit(work));
+    }
+    for (auto &task : tasks) {
+      task.get();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Восходящая сортировка слиянием: корзина i хранит отсортированную цепочку
+  // из 2^i узлов. Узлы только перецепляются, память не выделяется
+  template <typename Compare>
+  static void SortChain(Node *&chain, Compare &comp) {
+    constexpr size_t kBucketCount = 64;
+    Node *buckets[kBucketCount] = {};
+    Node *rest = chain;
+    Node *carry = nullptr;
+    try {
+      while (rest != nullptr) {
+        carry = rest;
+        rest = rest->next_node_;
+        carry->next_node_ = nullptr;
+        size_t i = 0;
+        for (; buckets[i] != nullptr; ++i) {
+          MergeChains(buckets[i], std::exchange(carry, nullptr), comp);
+          carry = std::exchange(buckets[i], nullptr);
+        }
+        buckets[i] = std::exchange(carry, nullptr);
+      }
+      for (Node *&bucket : buckets) {
+        if (bucket != nullptr) {
+          MergeChains(bucket, std::exchange(carry, nullptr), comp);
+          carry = std::exchange(bucket, nullptr);
+        }
+      }
+      chain = carry;
+    } catch (...) {
+      NodeBase collected;
+      NodeBase *tail = &collected;
+      AppendChain(tail, carry);
+      for (Node *bucket : buckets) {
+        AppendChain(tail, bucket);
+      }
+      tail->next_node_ = rest;
+      chain = collected.next_node_;
+      throw;
     }
-    swap(temp_);
   }
 
  public:
   using Iterator = BasicIterator<Type>;
   using ConstIterator = BasicIterator<const Type>;
+  using AllocatorType = Allocator;
 
-  SingleLinkedList(std::initializer_list<Type> values) {
+  explicit SingleLinkedList(const Allocator& alloc) : alloc_(alloc) {}
+
+  SingleLinkedList(std::initializer_list<Type> values,
+                   const Allocator& alloc = Allocator())
+      : alloc_(alloc) {
     reassign(values.begin(), values.end());
   }
 
-  SingleLinkedList(const SingleLinkedList& other) {
+  template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+  SingleLinkedList(InputIt first, InputIt last,
+                   const Allocator& alloc = Allocator())
+      : alloc_(alloc) {
+    reassign(first, last);
+  }
+
+  SingleLinkedList(const SingleLinkedList& other)
+      : alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kCopy);
     reassign(other.begin(), other.end());
   }
 
+  // Забирает узлы и резерв other за O(1), other остаётся пустым
+  SingleLinkedList(SingleLinkedList&& other) noexcept
+      : alloc_(std::move(other.alloc_)) {
+    StealNodes(other);
+    SwapFreeNodes(other);
+  }
+
+  // Если присваивание элементов не бросает исключений, узлы списка
+  // переиспользуются: недостающие узлы выделяются до изменения списка,
+  // поэтому строгая гарантия безопасности сохраняется. Если аллокатор
+  // заменяется другим, резерв сбрасывается
   SingleLinkedList& operator=(const SingleLinkedList& rhs) {
-    reassign(rhs.begin(), rhs.end());
+    if (this == &rhs) {
+      return *this;
+    }
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kCopy);
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != rhs.alloc_) {
+        ShrinkToFit();
+        Clear();
+      }
+      alloc_ = rhs.alloc_;
+    }
+    if constexpr (std::is_nothrow_copy_assignable_v<Type>) {
+      const size_t common_size = std::min(size_, rhs.size_);
+      auto rhs_rest = rhs.begin();
+      for (size_t i = 0; i < common_size; ++i) {
+        ++rhs_rest;
+      }
+      SingleLinkedList extra = BuildChain(rhs_rest, rhs.end());
+
+      NodeBase* tail = &head_;
+      for (auto it = rhs.begin(); it != rhs_rest; ++it) {
+        tail = tail->next_node_;
+        static_cast<Node*>(tail)->value_ = *it;
+      }
+      EraseChainAfter(tail);
+      instrumentation_.OnAllocate(extra.size_);
+      if (extra.tail_ != nullptr) {
+        tail_ = std::exchange(extra.tail_, nullptr);
+      }
+      tail->next_node_ = std::exchange(extra.head_.next_node_, nullptr);
+      size_ += std::exchange(extra.size_, 0);
+    } else {
+      reassign(rhs.begin(), rhs.end());
+    }
     return *this;
   }
 
-  // Обменивает содержимое списков за время O(1)
+  // Заменяет содержимое копиями [first, last), переписывая значения в уже
+  // существующих узлах. Обеспечивает базовую гарантию безопасности
+  template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+  void Assign(InputIt first, InputIt last) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kAssign);
+    NodeBase* tail = &head_;
+    for (; *tail && first != last; ++first) {
+      tail = tail->next_node_;
+      static_cast<Node*>(tail)->value_ = *first;
+    }
+    EraseChainAfter(tail);
+    AppendRange(tail, first, last);
+  }
+
+  void Assign(std::initializer_list<Type> values) {
+    Assign(values.begin(), values.end());
+  }
+
+  // Вместе с узлами забирает резерв rhs. Если аллокаторы несовместимы,
+  // элементы перемещаются поштучно, а резервы остаются на месте
+  SingleLinkedList& operator=(SingleLinkedList&& rhs) noexcept(
+      NodeTraits::propagate_on_container_move_assignment::value ||
+      NodeTraits::is_always_equal::value) {
+    if (this == &rhs) {
+      return *this;
+    }
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+      ShrinkToFit();
+      Clear();
+      alloc_ = std::move(rhs.alloc_);
+      StealNodes(rhs);
+      SwapFreeNodes(rhs);
+    } else {
+      if (alloc_ == rhs.alloc_) {
+        ShrinkToFit();
+        Clear();
+        StealNodes(rhs);
+        SwapFreeNodes(rhs);
+      } else {
+        reassign(std::make_move_iterator(rhs.begin()),
+                 std::make_move_iterator(rhs.end()));
+        rhs.Clear();
+      }
+    }
+    return *this;
+  }
+
+  // Обменивает содержимое и резервы списков за время O(1)
   void swap(SingleLinkedList& other) noexcept {
-    if (*this != other && !other.IsEmpty()) {
+    if (this != &other) {
+      InvalidateIndex();
+      other.InvalidateIndex();
       std::swap(head_.next_node_, other.head_.next_node_);
+      std::swap(tail_, other.tail_);
       std::swap(size_ , other.size_);
+      SwapFreeNodes(other);
+      if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+      } else {
+        assert(alloc_ == other.alloc_);
+      }
     }
   }
 
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return Allocator(alloc_);
+  }
+
   [[nodiscard]] Iterator begin() noexcept {
-    return IsEmpty() && head_ ? Iterator(nullptr) : Iterator(head_.next_node_);
+    return IsEmpty() && head_ ? Iterator(nullptr)
+                              : Iterator(head_.next_node_, GetProbe());
   }
 
   [[nodiscard]] Iterator end() noexcept { return Iterator(nullptr); }
 
   [[nodiscard]] ConstIterator begin() const noexcept {
     return IsEmpty() && head_ ? ConstIterator(nullptr)
-                              : ConstIterator(head_.next_node_);
+                              : ConstIterator(head_.next_node_, GetProbe());
   }
 
   [[nodiscard]] ConstIterator end() const noexcept {
@@ -142,14 +1008,14 @@ class SingleLinkedList {
 
   [[nodiscard]] ConstIterator cbegin() const noexcept {
     return IsEmpty() && head_ ? ConstIterator(nullptr)
-                              : ConstIterator(head_.next_node_);
+                              : ConstIterator(head_.next_node_, GetProbe());
   }
 
   [[nodiscard]] ConstIterator cend() const noexcept {
     return ConstIterator(nullptr);
   }
 
-  SingleLinkedList() = default;
+  SingleLinkedList() : SingleLinkedList(Allocator()) {}
 
   [[nodiscard]] size_t GetSize() const noexcept { return size_; }
 
@@ -157,62 +1023,739 @@ class SingleLinkedList {
     return static_cast<int>(GetSize()) == 0;
   }
 
-  void PushFront(const Type &value) {
-    head_.next_node_ = new Node(value, head_.next_node_);
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  // Конструирует элемент в начале списка без промежуточных копий
+  template <typename... Args>
+  Type &EmplaceFront(Args &&...args) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kPushFront);
+    head_.next_node_ = CreateNode(head_.next_node_, std::forward<Args>(args)...);
+    if (tail_ == nullptr) {
+      tail_ = head_.next_node_;
+    }
+    ++size_;
+    IndexPushedFront();
+    return head_.next_node_->value_;
+  }
+
+  void PushBack(const Type &value) { EmplaceBack(value); }
+
+  void PushBack(Type &&value) { EmplaceBack(std::move(value)); }
+
+  // Конструирует элемент в конце списка за O(1)
+  template <typename... Args>
+  Type &EmplaceBack(Args &&...args) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kPushBack);
+    Node *node = CreateNode(nullptr, std::forward<Args>(args)...);
+    InvalidateIndex();
+    GetTail()->next_node_ = node;
+    tail_ = node;
     ++size_;
+    return node->value_;
+  }
+
+  // Удаляет первый элемент непустого списка
+  void PopFront() noexcept {
+    assert(!IsEmpty());
+    EraseAfter(cbefore_begin());
+  }
+
+  // Позиция перед первым элементом для InsertAfter, EraseAfter и SpliceAfter
+  [[nodiscard]] Iterator before_begin() noexcept { return Iterator(&head_); }
+
+  [[nodiscard]] ConstIterator before_begin() const noexcept {
+    return ConstIterator(const_cast<NodeBase *>(&head_));
+  }
+
+  [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+    return before_begin();
+  }
+
+  Iterator InsertAfter(ConstIterator pos, const Type &value) {
+    return EmplaceAfter(pos, value);
+  }
+
+  Iterator InsertAfter(ConstIterator pos, Type &&value) {
+    return EmplaceAfter(pos, std::move(value));
+  }
+
+  // Конструирует элемент после pos и возвращает итератор на него
+  template <typename... Args>
+  Iterator EmplaceAfter(ConstIterator pos, Args &&...args) {
+    assert(pos.node_);
+    Node *node = CreateNode(pos.node_->next_node_, std::forward<Args>(args)...);
+    pos.node_->next_node_ = node;
+    if (node->next_node_ == nullptr) {
+      tail_ = node;
+    }
+    ++size_;
+    if (pos.node_ == &head_) {
+      IndexPushedFront();
+    } else {
+      InvalidateIndex();
+    }
+    return Iterator(node, GetProbe());
   }
 
-  void Clear() {
+  // Удаляет элемент после pos и возвращает итератор на следующий за ним
+  Iterator EraseAfter(ConstIterator pos) noexcept {
+    assert(pos.node_ && pos.node_->next_node_);
+    NodeBase *before = pos.node_;
+    if (before == &head_) {
+      IndexPoppingFront();
+    } else {
+      InvalidateIndex();
+    }
+    Node *node = before->next_node_;
+    before->next_node_ = node->next_node_;
+    if (tail_ == node) {
+      tail_ = AsNode(before);
+    }
+    DestroyNode(node);
+    --size_;
+    return Iterator(before->next_node_, GetProbe());
+  }
+
+  // Переносит все элементы other в позицию после pos перецеплением узлов за
+  // O(1), other становится пустым. Аллокаторы списков должны совпадать
+  void SpliceAfter(ConstIterator pos, SingleLinkedList &other) noexcept {
+    if (this == &other || other.IsEmpty()) {
+      return;
+    }
+    SpliceRangeAfter(pos.node_, other, &other.head_, other.tail_, other.size_);
+  }
+
+  void SpliceAfter(ConstIterator pos, SingleLinkedList &&other) noexcept {
+    SpliceAfter(pos, other);
+  }
+
+  // Переносит за O(1) один элемент, следующий за before в списке other
+  void SpliceAfter(ConstIterator pos, SingleLinkedList &other,
+                   ConstIterator before) noexcept {
+    assert(before.node_ && before.node_->next_node_);
+    Node *node = before.node_->next_node_;
+    if (pos.node_ == before.node_ || pos.node_ == node) {
+      return;
+    }
+    SpliceRangeAfter(pos.node_, other, before.node_, node, 1);
+  }
+
+  // Переносит элементы интервала (first, last) списка other. Интервал
+  // проходится один раз, чтобы найти последний узел и пересчитать размеры
+  void SpliceAfter(ConstIterator pos, SingleLinkedList &other,
+                   ConstIterator first, ConstIterator last) noexcept {
+    assert(first.node_);
+    if (first.node_->next_node_ == last.node_) {
+      return;
+    }
+    size_t count = 0;
+    NodeBase *node = first.node_;
+    while (node->next_node_ != last.node_) {
+      node = node->next_node_;
+      ++count;
+      assert(node != pos.node_);
+    }
+    SpliceRangeAfter(pos.node_, other, first.node_, static_cast<Node *>(node),
+                     count);
+  }
+
+  // Дописывает все элементы other в конец списка за O(1)
+  void Append(SingleLinkedList &&other) noexcept {
+    SpliceAfter(ConstIterator(GetTail()), other);
+  }
+
+  // Если список единолично владеет ареной аллокатора, узлы освобождаются
+  // целиком за O(числа блоков) вместо поштучного освобождения. При заданном
+  // резерве узлы поштучно возвращаются в список свободных
+  void Clear() noexcept {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kClear);
+    if (index_) {
+      index_->entries_.clear();
+      index_->entry_of_.clear();
+      index_->valid_ = true;
+    }
+    if (reclaimer_ != nullptr && head_ && reserved_ == 0) {
+      if constexpr (NodeTraits::is_always_equal::value) {
+        Node *chain = head_.next_node_;
+        try {
+          reclaimer_->Submit([chain, alloc = alloc_]() mutable noexcept {
+            DestroyChain(alloc, chain);
+          });
+          instrumentation_.OnDeallocate(size_);
+          head_.next_node_ = nullptr;
+          tail_ = nullptr;
+          size_ = 0;
+          return;
+        } catch (...) {
+          // Не удалось поставить задачу: освобождаем узлы в текущем потоке
+        }
+      }
+    }
+    if constexpr (kBulkRelease) {
+      if (alloc_.IsExclusive() && reserved_ == 0) {
+        assert(free_nodes_ == nullptr);
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+          for (Node *node = head_.next_node_; node != nullptr;) {
+            Node *next = node->next_node_;
+            NodeTraits::destroy(alloc_, node);
+            node = next;
+          }
+        }
+        alloc_.ReleaseAll();
+        instrumentation_.OnDeallocate(size_);
+        head_.next_node_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        return;
+      }
+    }
     while (head_) {
       Node *next = head_.next_node_->next_node_;
-      delete head_.next_node_;
+      DestroyNode(head_.next_node_);
       head_.next_node_ = next;
     }
+    tail_ = nullptr;
     size_ = 0;
   }
 
-  ~SingleLinkedList() { Clear(); }
+  // Выделяет память под узлы заранее, так что список вмещает count элементов
+  // без обращений к аллокатору. Удалённые узлы (PopFront, EraseAfter, Clear)
+  // сохраняются для следующих вставок, пока ёмкость не превышает резерв.
+  // Строгая гарантия безопасности
+  void Reserve(size_t count) {
+    const size_t old_free_count = free_count_;
+    try {
+      while (size_ + free_count_ < count) {
+        Node *node = NodeTraits::allocate(alloc_, 1);
+        ::new (static_cast<void *>(node)) FreeNode{free_nodes_};
+        free_nodes_ = node;
+        ++free_count_;
+      }
+    } catch (...) {
+      while (free_count_ > old_free_count) {
+        NodeTraits::deallocate(alloc_, TakeFreeNode(), 1);
+      }
+      throw;
+    }
+    reserved_ = std::max(reserved_, count);
+  }
+
+  // Возвращает аллокатору сохранённую память узлов и сбрасывает резерв
+  void ShrinkToFit() noexcept {
+    ReleaseFreeNodes();
+    reserved_ = 0;
+  }
+
+  // Число элементов, которое список вмещает без выделения памяти
+  [[nodiscard]] size_t GetCapacity() const noexcept {
+    return size_ + free_count_;
+  }
+
+  // Включает отложенное освобождение: Clear и деструктор отцепляют цепочку
+  // узлов за O(1) и освобождают её в потоке reclaimer. nullptr выключает режим.
+  // Настройка принадлежит объекту списка и не переносится копированием,
+  // перемещением и обменом. Доступно для аллокаторов без состояния
+  void SetReclaimer(BackgroundReclaimer *reclaimer) noexcept {
+    static_assert(NodeTraits::is_always_equal::value,
+                  "Deferred destruction requires a stateless allocator");
+    reclaimer_ = reclaimer;
+  }
+
+  // Включает позиционный индекс с шагом stride: At, IteratorAt и Advance
+  // выполняются за O(stride) шагов по узлам (Advance — с поиском по индексу
+  // за O(size / stride)). Индекс строится лениво при первом неконстантном
+  // обращении и занимает size / stride указателей. Настройка не переносится копированием,
+  // перемещением и обменом
+  void EnablePositionalIndex(size_t stride = kDefaultIndexStride) {
+    assert(stride > 0);
+    index_ = std::make_unique<PositionalIndex>();
+    index_->stride_ = stride;
+  }
+
+  void DisablePositionalIndex() noexcept { index_.reset(); }
+
+  [[nodiscard]] bool HasPositionalIndex() const noexcept {
+    return index_ != nullptr;
+  }
+
+  // Заранее перестраивает устаревший индекс. Неконстантные At, IteratorAt и
+  // Advance перестраивают его сами, а константные только читают индекс и
+  // могут выполняться параллельно: при устаревшем индексе они обходят список
+  // от начала
+  void RebuildPositionalIndex() { GetValidIndex(); }
+
+  [[nodiscard]] Type &At(size_t position) {
+    return *IteratorAt(CheckPosition(position));
+  }
+
+  [[nodiscard]] const Type &At(size_t position) const {
+    return *IteratorAt(CheckPosition(position));
+  }
+
+  // Итератор на элемент в позиции position, для GetSize() — end()
+  [[nodiscard]] Iterator IteratorAt(size_t position) {
+    return Iterator(NodeAt(position, GetValidIndex()), GetProbe());
+  }
+
+  [[nodiscard]] ConstIterator IteratorAt(size_t position) const {
+    return ConstIterator(NodeAt(position, FindValidIndex()), GetProbe());
+  }
+
+  [[nodiscard]] Iterator Advance(Iterator it, size_t n) {
+    return Iterator(AdvanceNode(it.node_, n, GetValidIndex()), GetProbe());
+  }
+
+  [[nodiscard]] ConstIterator Advance(ConstIterator it, size_t n) const {
+    return ConstIterator(AdvanceNode(it.node_, n, FindValidIndex()), GetProbe());
+  }
+
+  // Устойчивая сортировка перецеплением узлов за O(n log n) без выделения памяти.
+  // Если comp выбрасывает исключение, элементы остаются в списке в неопределённом порядке
+  template <typename Compare = std::less<>>
+  void Sort(Compare comp = Compare()) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kSort);
+    InvalidateIndex();
+    try {
+      SortChain(head_.next_node_, comp);
+    } catch (...) {
+      RestoreTail();
+      throw;
+    }
+    RestoreTail();
+  }
+
+  // Сортирует сегменты списка в потоках пула и попарно сливает их.
+  // Короткие списки сортируются в вызывающем потоке
+  template <typename Compare = std::less<>>
+  void Sort(ThreadPool &pool, Compare comp = Compare()) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kSort);
+    InvalidateIndex();
+    const size_t segment_count =
+        std::min(pool.GetThreadCount(), size_ / kMinParallelSortSegment);
+    if (segment_count < 2) {
+      Sort(comp);
+      return;
+    }
+
+    std::vector<Node *> segments(segment_count);
+    Node *node = head_.next_node_;
+    for (size_t i = 0; i < segment_count; ++i) {
+      segments[i] = node;
+      const size_t length =
+          size_ / segment_count + (i < size_ % segment_count ? 1 : 0);
+      for (size_t j = 1; j < length; ++j) {
+        node = node->next_node_;
+      }
+      node = std::exchange(node->next_node_, nullptr);
+    }
+    head_.next_node_ = nullptr;
+
+    std::vector<std::future<void>> tasks;
+    std::exception_ptr error;
+    const auto wait_all = [&tasks, &error] {
+      for (auto &task : tasks) {
+        try {
+          task.get();
+        } catch (...) {
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+      tasks.clear();
+    };
+
+    for (Node *&segment : segments) {
+      tasks.push_back(pool.Submit([&segment, comp]() mutable {
+        SortChain(segment, comp);
+      }));
+    }
+    wait_all();
+    for (size_t step = 1; !error && step < segment_count; step *= 2) {
+      for (size_t i = 0; i + step < segment_count; i += 2 * step) {
+        tasks.push_back(pool.Submit([&segments, i, step, comp]() mutable {
+          MergeChains(segments[i], std::exchange(segments[i + step], nullptr),
+                      comp);
+        }));
+      }
+      wait_all();
+    }
+
+    NodeBase *tail = &head_;
+    for (Node *segment : segments) {
+      AppendChain(tail, segment);
+    }
+    tail_ = AsNode(tail);
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Сливает отсортированный список other в текущий перецеплением узлов,
+  // other становится пустым. Аллокаторы списков должны совпадать
+  template <typename Compare = std::less<>>
+  void Merge(SingleLinkedList &other, Compare comp = Compare()) {
+    if (this == &other) {
+      return;
+    }
+    assert(alloc_ == other.alloc_);
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kMerge);
+    InvalidateIndex();
+    other.InvalidateIndex();
+    size_ += std::exchange(other.size_, 0);
+    Node *other_tail = std::exchange(other.tail_, nullptr);
+    try {
+      MergeChains(head_.next_node_,
+                  std::exchange(other.head_.next_node_, nullptr), comp);
+    } catch (...) {
+      RestoreTail();
+      throw;
+    }
+    // Последним остаётся хвост той цепочки, которая закончилась позже
+    if (tail_ == nullptr || tail_->next_node_ != nullptr) {
+      tail_ = other_tail;
+    }
+  }
+
+  template <typename Compare = std::less<>>
+  void Merge(SingleLinkedList &&other, Compare comp = Compare()) {
+    Merge(other, comp);
+  }
+
+  // Перекладывает узлы в порядке обхода: для арены — в один непрерывный блок,
+  // для остальных аллокаторов — поштучно подряд, что обычно даёт соседние
+  // адреса. Арена, которой владеет только этот список, заменяется новой, и
+  // память старой освобождается. Порядок и число элементов сохраняются, все
+  // итераторы становятся недействительными. Строгая гарантия безопасности
+  CompactionReport Compact() {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kCompact);
+    InvalidateIndex();
+    CompactionReport report;
+    report.bytes_before = GetBytesHeld();
+    report.page_visits_before = CountPageVisits();
+    if (size_ == 0) {
+      report.bytes_after = report.bytes_before;
+      return report;
+    }
+
+    Node *first = nullptr;
+    Node *last = nullptr;
+    bool release_old = false;
+    if constexpr (kBulkRelease) {
+      NodeAllocator fresh = NodeTraits::select_on_container_copy_construction(alloc_);
+      if (alloc_.IsExclusive() && fresh != alloc_) {
+        // Список свободных лежит в старой арене и переносится в новую
+        const size_t spare_count = free_count_;
+        Node *block = NodeTraits::allocate(fresh, size_);
+        Node *spare = nullptr;
+        try {
+          if (spare_count > 0) {
+            spare = NodeTraits::allocate(fresh, spare_count);
+          }
+          first = RelocateChain(fresh, block, last);
+        } catch (...) {
+          if (spare != nullptr) {
+            NodeTraits::deallocate(fresh, spare, spare_count);
+          }
+          throw;
+        }
+        release_old = true;
+        for (Node *node = head_.next_node_; node != nullptr;) {
+          Node *next = node->next_node_;
+          NodeTraits::destroy(alloc_, node);
+          node = next;
+        }
+        alloc_.ReleaseAll();
+        alloc_ = std::move(fresh);
+        free_nodes_ = nullptr;
+        free_count_ = 0;
+        for (size_t i = spare_count; i > 0; --i) {
+          ::new (static_cast<void *>(spare + i - 1)) FreeNode{free_nodes_};
+          free_nodes_ = spare + i - 1;
+          ++free_count_;
+        }
+      } else {
+        first = RelocateChain(alloc_, NodeTraits::allocate(alloc_, size_), last);
+      }
+    } else {
+      first = RelocateChain(alloc_, nullptr, last);
+    }
+    if (!release_old) {
+      DestroyChain(alloc_, std::exchange(head_.next_node_, nullptr));
+    }
+    instrumentation_.OnAllocate(size_);
+    instrumentation_.OnDeallocate(size_);
+    head_.next_node_ = first;
+    tail_ = last;
+
+    report.bytes_after = GetBytesHeld();
+    report.page_visits_after = CountPageVisits();
+    return report;
+  }
+
+  // Отношение числа смен страниц при обходе к минимальному числу страниц,
+  // которое заняли бы узлы. 1 соответствует плотной укладке
+  [[nodiscard]] double GetFragmentation() const noexcept {
+    if (size_ == 0) {
+      return 1.0;
+    }
+    const size_t min_pages =
+        (size_ * sizeof(Node) + detail::kPageSize - 1) / detail::kPageSize;
+    return static_cast<double>(CountPageVisits()) /
+           static_cast<double>(min_pages);
+  }
+
+  // Сжимает список, если фрагментация превышает threshold. Подходит для
+  // периодического вызова в периоды простоя
+  std::optional<CompactionReport> CompactIfFragmented(
+      double threshold = kDefaultFragmentationThreshold) {
+    if (GetFragmentation() <= threshold) {
+      return std::nullopt;
+    }
+    return Compact();
+  }
+
+  // Удаляет подряд идущие эквивалентные элементы, возвращает число удалённых
+  template <typename BinaryPredicate = std::equal_to<>>
+  size_t Unique(BinaryPredicate pred = BinaryPredicate()) {
+    [[maybe_unused]] const auto timer =
+        instrumentation_.Measure(ListOperation::kUnique);
+    InvalidateIndex();
+    const size_t old_size = size_;
+    for (Node *node = head_.next_node_; node != nullptr; node = node->next_node_) {
+      while (node->next_node_ != nullptr &&
+             pred(node->value_, node->next_node_->value_)) {
+        DestroyNode(std::exchange(node->next_node_,
+                                  node->next_node_->next_node_));
+        --size_;
+      }
+      if (node->next_node_ == nullptr) {
+        tail_ = node;
+      }
+    }
+    return old_size - size_;
+  }
+
+  // Алгоритмы обхода с программной предвыборкой узлов на PrefetchDistance
+  // узлов вперёд: list.ForEach<8>(func)
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance, typename Func>
+  void ForEach(Func func) {
+    auto visit = [&func](Node *node) {
+      func(node->value_);
+      return true;
+    };
+    WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit);
+  }
+
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance, typename Func>
+  void ForEach(Func func) const {
+    auto visit = [&func](Node *node) {
+      func(std::as_const(node->value_));
+      return true;
+    };
+    WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit);
+  }
+
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance, typename T,
+            typename BinaryOp = std::plus<>>
+  [[nodiscard]] T Accumulate(T init, BinaryOp op = BinaryOp()) const {
+    auto visit = [&init, &op](Node *node) {
+      init = op(std::move(init), std::as_const(node->value_));
+      return true;
+    };
+    WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit);
+    return init;
+  }
+
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance,
+            typename Predicate>
+  [[nodiscard]] Iterator FindIf(Predicate pred) {
+    auto visit = [&pred](Node *node) { return !pred(node->value_); };
+    return Iterator(WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit),
+                    GetProbe());
+  }
+
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance,
+            typename Predicate>
+  [[nodiscard]] ConstIterator FindIf(Predicate pred) const {
+    auto visit = [&pred](Node *node) {
+      return !pred(std::as_const(node->value_));
+    };
+    return ConstIterator(
+        WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit),
+        GetProbe());
+  }
+
+  template <size_t PrefetchDistance = kDefaultPrefetchDistance,
+            typename Predicate>
+  [[nodiscard]] size_t CountIf(Predicate pred) const {
+    size_t count = 0;
+    auto visit = [&pred, &count](Node *node) {
+      count += pred(std::as_const(node->value_)) ? 1 : 0;
+      return true;
+    };
+    WalkWithPrefetch<PrefetchDistance>(head_.next_node_, visit);
+    return count;
+  }
+
+  // Параллельные алгоритмы над потоками пула. func и op вызываются
+  // одновременно из нескольких потоков для разных элементов и должны это
+  // допускать. Короткие списки обрабатываются в вызывающем потоке
+  template <typename Func>
+  void ForEach(ThreadPool &pool, Func func) {
+    auto process = [&func](size_t, Node *node, size_t length) {
+      for (; length > 0; --length, node = node->next_node_) {
+        func(node->value_);
+      }
+    };
+    RunSegments(pool, process);
+  }
+
+  template <typename Func>
+  void ForEach(ThreadPool &pool, Func func) const {
+    auto process = [&func](size_t, Node *node, size_t length) {
+      for (; length > 0; --length, node = node->next_node_) {
+        func(std::as_const(node->value_));
+      }
+    };
+    RunSegments(pool, process);
+  }
+
+  // Заменяет каждый элемент результатом op(элемент)
+  template <typename UnaryOp>
+  void Transform(ThreadPool &pool, UnaryOp op) {
+    auto process = [&op](size_t, Node *node, size_t length) {
+      for (; length > 0; --length, node = node->next_node_) {
+        node->value_ = op(std::as_const(node->value_));
+      }
+    };
+    RunSegments(pool, process);
+  }
+
+  // Каждый сегмент сворачивается слева направо начиная со своего первого
+  // элемента, затем init и частичные результаты сворачиваются в порядке
+  // сегментов. Порядок применения op зависит только от размера списка,
+  // поэтому результат не зависит от числа потоков. op должен принимать
+  // (T, const Type&) и (T, T)
+  template <typename T, typename BinaryOp = std::plus<>>
+  [[nodiscard]] T Reduce(ThreadPool &pool, T init, BinaryOp op = BinaryOp()) const {
+    std::vector<std::optional<T>> partials(
+        (size_ + kMinParallelSortSegment - 1) / kMinParallelSortSegment);
+    auto process = [&op, &partials](size_t index, Node *node, size_t length) {
+      T partial(std::as_const(node->value_));
+      for (node = node->next_node_; --length > 0; node = node->next_node_) {
+        partial = op(std::move(partial), std::as_const(node->value_));
+      }
+      partials[index].emplace(std::move(partial));
+    };
+    RunSegments(pool, process);
+    for (auto &partial : partials) {
+      if (partial) {
+        init = op(std::move(init), std::move(*partial));
+      }
+    }
+    return init;
+  }
+
+  // Снимок статистики списка. Доступен только с включённой инструментацией
+  [[nodiscard]] ListStats GetStats() const noexcept {
+    static_assert(Instrumentation::kEnabled,
+                  "GetStats requires an enabled instrumentation policy");
+    ListStats stats = instrumentation_.Snapshot();
+    stats.bytes_held = GetBytesHeld();
+    return stats;
+  }
+
+  void ResetStats() noexcept {
+    static_assert(Instrumentation::kEnabled,
+                  "ResetStats requires an enabled instrumentation policy");
+    instrumentation_.Reset();
+  }
+
+  // Память под узлы с учётом накладных расходов аллокатора. Для арены это
+  // все её блоки, для остальных аллокаторов — оценка служебного заголовка
+  // malloc и выравнивания каждого узла
+  [[nodiscard]] size_t GetBytesHeld() const noexcept {
+    if constexpr (detail::HasReservedBytes<NodeAllocator>::value) {
+      return alloc_.GetReservedBytes();
+    } else {
+      constexpr size_t kMallocAlignment = 2 * sizeof(size_t);
+      constexpr size_t kNodeFootprint =
+          (sizeof(Node) + sizeof(size_t) + kMallocAlignment - 1) /
+          kMallocAlignment * kMallocAlignment;
+      return (size_ + free_count_) * kNodeFootprint;
+    }
+  }
+
+  ~SingleLinkedList() {
+    ShrinkToFit();
+    Clear();
+  }
 };
 
-template <typename Type>
-void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
+template <typename Type, typename Allocator, typename Instrumentation>
+void swap(SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+          SingleLinkedList<Type, Allocator, Instrumentation>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
-template <typename Type>
-bool operator==(const SingleLinkedList<Type>& lhs,
-                const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator==(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
     return (lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
 }
 
-template <typename Type>
-bool operator!=(const SingleLinkedList<Type>& lhs,
-                const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator!=(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename Type>
-bool operator<(const SingleLinkedList<Type>& lhs,
-               const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator<(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
   return std::lexicographical_compare(lhs.begin(), lhs.end(),
                                       rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-bool operator<=(const SingleLinkedList<Type>& lhs,
-                const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator<=(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
   return ((lhs == rhs || lhs < rhs));
 }
 
-template <typename Type>
-bool operator>(const SingleLinkedList<Type>& lhs,
-               const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator>(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
   return !(lhs <= rhs);
 }
 
-template <typename Type>
-bool operator>=(const SingleLinkedList<Type>& lhs,
-                const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Instrumentation>
+bool operator>=(
+    const SingleLinkedList<Type, Allocator, Instrumentation>& lhs,
+    const SingleLinkedList<Type, Allocator, Instrumentation>& rhs) {
   return !(lhs < rhs) ;
 }
 
+
+namespace pmr {
+
+template <typename Type>
+using SingleLinkedList =
+    ::SingleLinkedList<Type, std::pmr::polymorphic_allocator<Type>>;
+
+}  // namespace pmr
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Односвязный список с встроенным буфером: первые K узлов размещаются внутри
+// самого объекта списка, в куче выделяются только узлы сверх K. Освободившиеся
+// встроенные ячейки занимаются повторно. Перемещение и обмен переносят
+// встроенные элементы поштучно за O(n), итераторы на них становятся
+// недействительными. Если перемещение Type может бросить исключение,
+// встроенные элементы копируются (как std::move_if_noexcept), а перемещение
+// и обмен дают только базовую гарантию безопасности
+template <typename Type, size_t K = 8>
+class SmallSingleLinkedList {
+  static_assert(K > 0 && K <= 64, "Inline capacity must be in [1, 64]");
+
+  struct Node;
+
+  struct NodeBase {
+    Node *next_node_ = nullptr;
+    NodeBase() = default;
+    explicit NodeBase(Node *node) noexcept : next_node_(node) {}
+  };
+
+  struct Node : NodeBase {
+    Type value_;
+    template <typename... Args>
+    explicit Node(Node *node, Args &&...args)
+        : NodeBase(node), value_(std::forward<Args>(args)...) {}
+  };
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class SmallSingleLinkedList;
+    Node *node_ = nullptr;
+    explicit BasicIterator(Node *node) noexcept : node_(node) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    BasicIterator &operator=(const BasicIterator &rhs) = default;
+
+    BasicIterator(const BasicIterator<Type> &other) noexcept
+        : node_(other.node_) {}
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(node_);
+      node_ = node_->next_node_;
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(node_);
+      return node_->value_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(node_);
+      return &node_->value_;
+    }
+  };
+
+ public:
+  using Iterator = BasicIterator<Type>;
+  using ConstIterator = BasicIterator<const Type>;
+
+  static constexpr size_t kInlineCapacity = K;
+  static constexpr bool kNothrowMove = std::is_nothrow_move_constructible_v<Type>;
+
+  SmallSingleLinkedList() = default;
+
+  SmallSingleLinkedList(std::initializer_list<Type> values) {
+    AppendCopies(values.begin(), values.end());
+  }
+
+  SmallSingleLinkedList(const SmallSingleLinkedList &other) {
+    AppendCopies(other.begin(), other.end());
+  }
+
+  SmallSingleLinkedList(SmallSingleLinkedList &&other) noexcept(kNothrowMove) {
+    StealFrom(other);
+  }
+
+  // Строгая гарантия безопасности, если перемещение Type не бросает исключений
+  SmallSingleLinkedList &operator=(const SmallSingleLinkedList &rhs) {
+    if (this != &rhs) {
+      SmallSingleLinkedList temp_(rhs);
+      Clear();
+      StealFrom(temp_);
+    }
+    return *this;
+  }
+
+  SmallSingleLinkedList &operator=(SmallSingleLinkedList &&rhs) noexcept(
+      kNothrowMove) {
+    if (this != &rhs) {
+      Clear();
+      StealFrom(rhs);
+    }
+    return *this;
+  }
+
+  ~SmallSingleLinkedList() { Clear(); }
+
+  // Обменивает содержимое списков. Узлы из кучи перецепляются, встроенные
+  // элементы перемещаются
+  void swap(SmallSingleLinkedList &other) noexcept(kNothrowMove) {
+    if (this != &other) {
+      SmallSingleLinkedList temp_(std::move(other));
+      other.StealFrom(*this);
+      StealFrom(temp_);
+    }
+  }
+
+  [[nodiscard]] Iterator begin() noexcept { return Iterator(head_.next_node_); }
+
+  [[nodiscard]] Iterator end() noexcept { return Iterator(nullptr); }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_.next_node_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  // Число элементов, узлы которых выделены в куче
+  [[nodiscard]] size_t GetHeapSize() const noexcept {
+    return size_ - CountInline();
+  }
+
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  template <typename... Args>
+  Type &EmplaceFront(Args &&...args) {
+    head_.next_node_ = CreateNode(head_.next_node_, std::forward<Args>(args)...);
+    ++size_;
+    return head_.next_node_->value_;
+  }
+
+  // Удаляет первый элемент, встроенная ячейка становится свободной
+  void PopFront() noexcept {
+    assert(!IsEmpty());
+    DestroyNode(std::exchange(head_.next_node_, head_.next_node_->next_node_));
+    --size_;
+  }
+
+  void Clear() noexcept {
+    while (head_.next_node_ != nullptr) {
+      DestroyNode(std::exchange(head_.next_node_, head_.next_node_->next_node_));
+    }
+    size_ = 0;
+  }
+
+ private:
+  static constexpr uint64_t kAllSlots =
+      K == 64 ? ~uint64_t{0} : (uint64_t{1} << K) - 1;
+
+  [[nodiscard]] Node *SlotAddress(size_t index) noexcept {
+    return reinterpret_cast<Node *>(inline_storage_ + index * sizeof(Node));
+  }
+
+  [[nodiscard]] bool IsInline(const Node *node) const noexcept {
+    const auto *address = reinterpret_cast<const std::byte *>(node);
+    return !std::less<const std::byte *>()(address, inline_storage_) &&
+           std::less<const std::byte *>()(address,
+                                          inline_storage_ + sizeof(inline_storage_));
+  }
+
+  [[nodiscard]] size_t SlotIndex(const Node *node) const noexcept {
+    return static_cast<size_t>(reinterpret_cast<const std::byte *>(node) -
+                               inline_storage_) /
+           sizeof(Node);
+  }
+
+  [[nodiscard]] size_t CountInline() const noexcept {
+    size_t count = 0;
+    for (uint64_t used = used_slots_; used != 0; used &= used - 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Занимает свободную встроенную ячейку, а если их нет — память в куче
+  template <typename... Args>
+  Node *CreateNode(Node *next, Args &&...args) {
+    if (used_slots_ != kAllSlots) {
+      size_t index = 0;
+      while ((used_slots_ >> index) & 1) {
+        ++index;
+      }
+      Node *node = ::new (static_cast<void *>(SlotAddress(index)))
+          Node(next, std::forward<Args>(args)...);
+      used_slots_ |= uint64_t{1} << index;
+      return node;
+    }
+    return new Node(next, std::forward<Args>(args)...);
+  }
+
+  void DestroyNode(Node *node) noexcept {
+    if (IsInline(node)) {
+      const size_t index = SlotIndex(node);
+      node->~Node();
+      used_slots_ &= ~(uint64_t{1} << index);
+    } else {
+      delete node;
+    }
+  }
+
+  template <typename I>
+  void AppendCopies(I begin_, I end_) {
+    NodeBase *tail = &head_;
+    try {
+      for (; begin_ != end_; ++begin_) {
+        tail->next_node_ = CreateNode(nullptr, *begin_);
+        tail = tail->next_node_;
+        ++size_;
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  // Переносит встроенные элементы other в ячейки с теми же номерами
+  void CopyInlineSlots(SmallSingleLinkedList &other) noexcept(kNothrowMove) {
+    for (Node *node = other.head_.next_node_; node != nullptr;
+         node = node->next_node_) {
+      if (other.IsInline(node)) {
+        const size_t index = other.SlotIndex(node);
+        ::new (static_cast<void *>(SlotAddress(index)))
+            Node(nullptr, std::move_if_noexcept(node->value_));
+        used_slots_ |= uint64_t{1} << index;
+      }
+    }
+  }
+
+  // Забирает элементы other в пустой список: встроенные элементы сначала
+  // переносятся в ячейки с тем же номером, затем узлы из кучи перецепляются.
+  // Если перенос бросил исключение, other не меняется (кроме уже
+  // перемещённых значений), а список остаётся пустым
+  void StealFrom(SmallSingleLinkedList &other) noexcept(kNothrowMove) {
+    assert(IsEmpty());
+    if constexpr (kNothrowMove) {
+      CopyInlineSlots(other);
+    } else {
+      try {
+        CopyInlineSlots(other);
+      } catch (...) {
+        for (size_t index = 0; index < K; ++index) {
+          if ((used_slots_ >> index) & 1) {
+            SlotAddress(index)->~Node();
+          }
+        }
+        used_slots_ = 0;
+        throw;
+      }
+    }
+    NodeBase *tail = &head_;
+    for (Node *node = other.head_.next_node_; node != nullptr;) {
+      Node *next = node->next_node_;
+      if (other.IsInline(node)) {
+        const size_t index = other.SlotIndex(node);
+        other.DestroyNode(node);
+        node = SlotAddress(index);
+      }
+      tail->next_node_ = node;
+      tail = node;
+      node = next;
+    }
+    tail->next_node_ = nullptr;
+    other.head_.next_node_ = nullptr;
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  NodeBase head_;
+  size_t size_ = 0;
+  // Бит i установлен, если встроенная ячейка i занята узлом
+  uint64_t used_slots_ = 0;
+  alignas(Node) std::byte inline_storage_[K * sizeof(Node)];
+};
+
+template <typename Type, size_t K>
+void swap(SmallSingleLinkedList<Type, K> &lhs,
+          SmallSingleLinkedList<Type, K> &rhs) noexcept(
+    SmallSingleLinkedList<Type, K>::kNothrowMove) {
+  lhs.swap(rhs);
+}
+
+template <typename Type, size_t K>
+bool operator==(const SmallSingleLinkedList<Type, K> &lhs,
+                const SmallSingleLinkedList<Type, K> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, size_t K>
+bool operator!=(const SmallSingleLinkedList<Type, K> &lhs,
+                const SmallSingleLinkedList<Type, K> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type, size_t K>
+bool operator<(const SmallSingleLinkedList<Type, K> &lhs,
+               const SmallSingleLinkedList<Type, K> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type, size_t K>
+bool operator<=(const SmallSingleLinkedList<Type, K> &lhs,
+                const SmallSingleLinkedList<Type, K> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type, size_t K>
+bool operator>(const SmallSingleLinkedList<Type, K> &lhs,
+               const SmallSingleLinkedList<Type, K> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type, size_t K>
+bool operator>=(const SmallSingleLinkedList<Type, K> &lhs,
+                const SmallSingleLinkedList<Type, K> &rhs) {
+  return !(lhs < rhs);
+}
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченный список на основе списка с пропусками. Нижний уровень — обычный
+// односвязный список всех элементов в порядке comp, по нему идут итераторы.
+// Узел случайной высоты дополнительно связан с узлами верхних уровней, поэтому
+// Insert, Find, LowerBound, UpperBound и Erase выполняются в среднем за O(log n).
+// Эквивалентные элементы хранятся в порядке вставки. Элементы доступны только
+// для чтения, так как их изменение нарушило бы порядок
+template <typename Type, typename Compare = std::less<Type>>
+class SortedSingleLinkedList {
+  static_assert(alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "Over-aligned types are not supported");
+
+  static constexpr size_t kMaxHeight = 32;
+
+  // За узлом в той же области памяти лежат height_ указателей на следующие
+  // узлы каждого уровня
+  struct Node {
+    Type value_;
+    size_t height_;
+
+    template <typename... Args>
+    explicit Node(size_t height, Args &&...args)
+        : value_(std::forward<Args>(args)...), height_(height) {}
+
+    [[nodiscard]] Node **Links() noexcept {
+      return reinterpret_cast<Node **>(this + 1);
+    }
+  };
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class SortedSingleLinkedList;
+    Node *node_ = nullptr;
+    explicit BasicIterator(Node *node) noexcept : node_(node) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    [[nodiscard]] bool operator==(const BasicIterator &rhs) const noexcept {
+      return node_ == rhs.node_;
+    }
+
+    [[nodiscard]] bool operator!=(const BasicIterator &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(node_);
+      node_ = node_->Links()[0];
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(node_);
+      return node_->value_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(node_);
+      return &node_->value_;
+    }
+  };
+
+ public:
+  using ConstIterator = BasicIterator<const Type>;
+  using Iterator = ConstIterator;
+
+  explicit SortedSingleLinkedList(Compare comp = Compare()) : comp_(comp) {}
+
+  SortedSingleLinkedList(std::initializer_list<Type> values,
+                         Compare comp = Compare())
+      : comp_(comp) {
+    try {
+      for (const Type &value : values) {
+        Insert(value);
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  // Копия повторяет высоты узлов оригинала и строится за O(n)
+  SortedSingleLinkedList(const SortedSingleLinkedList &other)
+      : comp_(other.comp_), random_state_(other.random_state_) {
+    Node **tails[kMaxHeight];
+    for (size_t level = 0; level < kMaxHeight; ++level) {
+      tails[level] = &head_[level];
+    }
+    try {
+      for (Node *source = other.head_[0]; source != nullptr;
+           source = source->Links()[0]) {
+        Node *node = CreateNode(source->height_, source->value_);
+        for (size_t level = 0; level < node->height_; ++level) {
+          *tails[level] = node;
+          tails[level] = &node->Links()[level];
+        }
+        ++size_;
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    height_ = other.height_;
+  }
+
+  SortedSingleLinkedList(SortedSingleLinkedList &&other) noexcept
+      : comp_(other.comp_), random_state_(other.random_state_) {
+    StealNodes(other);
+  }
+
+  SortedSingleLinkedList &operator=(const SortedSingleLinkedList &rhs) {
+    if (this != &rhs) {
+      SortedSingleLinkedList temp_(rhs);
+      swap(temp_);
+    }
+    return *this;
+  }
+
+  SortedSingleLinkedList &operator=(SortedSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Clear();
+      comp_ = rhs.comp_;
+      StealNodes(rhs);
+    }
+    return *this;
+  }
+
+  ~SortedSingleLinkedList() { Clear(); }
+
+  void swap(SortedSingleLinkedList &other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    swap(head_, other.head_);
+    swap(height_, other.height_);
+    swap(size_, other.size_);
+    swap(random_state_, other.random_state_);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_[0]);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  ConstIterator Insert(const Type &value) { return Emplace(value); }
+
+  ConstIterator Insert(Type &&value) { return Emplace(std::move(value)); }
+
+  // Вставляет элемент после всех эквивалентных ему
+  template <typename... Args>
+  ConstIterator Emplace(Args &&...args) {
+    Node *node = CreateNode(RandomHeight(), std::forward<Args>(args)...);
+    Node **path[kMaxHeight];
+    try {
+      FindPath<true>(node->value_, path);
+    } catch (...) {
+      DestroyNode(node);
+      throw;
+    }
+    for (; height_ < node->height_; ++height_) {
+      path[height_] = &head_[height_];
+    }
+    for (size_t level = 0; level < node->height_; ++level) {
+      node->Links()[level] = *path[level];
+      *path[level] = node;
+    }
+    ++size_;
+    return ConstIterator(node);
+  }
+
+  // Первый элемент, не меньший value
+  [[nodiscard]] ConstIterator LowerBound(const Type &value) const {
+    Node **path[kMaxHeight];
+    FindPath<false>(value, path);
+    return ConstIterator(*path[0]);
+  }
+
+  // Первый элемент, больший value
+  [[nodiscard]] ConstIterator UpperBound(const Type &value) const {
+    Node **path[kMaxHeight];
+    FindPath<true>(value, path);
+    return ConstIterator(*path[0]);
+  }
+
+  // Первый элемент, эквивалентный value, или end()
+  [[nodiscard]] ConstIterator Find(const Type &value) const {
+    const ConstIterator it = LowerBound(value);
+    return it != end() && !comp_(value, *it) ? it : end();
+  }
+
+  [[nodiscard]] bool Contains(const Type &value) const {
+    return Find(value) != end();
+  }
+
+  // Удаляет все элементы, эквивалентные value, и возвращает их число
+  size_t Erase(const Type &value) {
+    Node **path[kMaxHeight];
+    FindPath<false>(value, path);
+    size_t erased = 0;
+    while (*path[0] != nullptr && !comp_(value, (*path[0])->value_)) {
+      Node *node = *path[0];
+      for (size_t level = 0; level < node->height_; ++level) {
+        assert(*path[level] == node);
+        *path[level] = node->Links()[level];
+      }
+      DestroyNode(node);
+      ++erased;
+    }
+    size_ -= erased;
+    while (height_ > 0 && head_[height_ - 1] == nullptr) {
+      --height_;
+    }
+    return erased;
+  }
+
+  void Clear() noexcept {
+    for (Node *node = head_[0]; node != nullptr;) {
+      DestroyNode(std::exchange(node, node->Links()[0]));
+    }
+    std::fill(std::begin(head_), std::end(head_), nullptr);
+    height_ = 0;
+    size_ = 0;
+  }
+
+ private:
+  template <typename... Args>
+  static Node *CreateNode(size_t height, Args &&...args) {
+    void *memory = ::operator new(sizeof(Node) + height * sizeof(Node *));
+    Node *node = nullptr;
+    try {
+      node = ::new (memory) Node(height, std::forward<Args>(args)...);
+    } catch (...) {
+      ::operator delete(memory);
+      throw;
+    }
+    std::fill_n(node->Links(), height, nullptr);
+    return node;
+  }
+
+  static void DestroyNode(Node *node) noexcept {
+    node->~Node();
+    ::operator delete(static_cast<void *>(node));
+  }
+
+  void StealNodes(SortedSingleLinkedList &other) noexcept {
+    std::copy(std::begin(other.head_), std::end(other.head_), std::begin(head_));
+    std::fill(std::begin(other.head_), std::end(other.head_), nullptr);
+    height_ = std::exchange(other.height_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  // Высота узла i с вероятностью 4^-(i-1)
+  size_t RandomHeight() noexcept {
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 7;
+    random_state_ ^= random_state_ << 17;
+    uint64_t bits = random_state_;
+    size_t height = 1;
+    while (height < kMaxHeight && (bits & 3) == 0) {
+      ++height;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  // Для каждого уровня находит ссылку, после которой должен стоять value:
+  // последнюю ссылку на узел меньше value или, если kAfterEquivalent, не больше
+  template <bool kAfterEquivalent>
+  void FindPath(const Type &value, Node **path[kMaxHeight]) const {
+    Node **links = const_cast<Node **>(head_);
+    for (size_t level = height_; level-- > 0;) {
+      while (links[level] != nullptr && Precedes<kAfterEquivalent>(
+                                            links[level]->value_, value)) {
+        links = links[level]->Links();
+      }
+      path[level] = &links[level];
+    }
+    if (height_ == 0) {
+      path[0] = &links[0];
+    }
+  }
+
+  template <bool kAfterEquivalent>
+  [[nodiscard]] bool Precedes(const Type &element, const Type &value) const {
+    if constexpr (kAfterEquivalent) {
+      return !comp_(value, element);
+    } else {
+      return comp_(element, value);
+    }
+  }
+
+  Node *head_[kMaxHeight] = {};
+  size_t height_ = 0;
+  size_t size_ = 0;
+  [[no_unique_address]] Compare comp_;
+  uint64_t random_state_ = 0x9E3779B97F4A7C15ull;
+};
+
+template <typename Type, typename Compare>
+void swap(SortedSingleLinkedList<Type, Compare> &lhs,
+          SortedSingleLinkedList<Type, Compare> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename Type, typename Compare>
+bool operator==(const SortedSingleLinkedList<Type, Compare> &lhs,
+                const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, typename Compare>
+bool operator!=(const SortedSingleLinkedList<Type, Compare> &lhs,
+                const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type, typename Compare>
+bool operator<(const SortedSingleLinkedList<Type, Compare> &lhs,
+               const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type, typename Compare>
+bool operator<=(const SortedSingleLinkedList<Type, Compare> &lhs,
+                const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type, typename Compare>
+bool operator>(const SortedSingleLinkedList<Type, Compare> &lhs,
+               const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type, typename Compare>
+bool operator>=(const SortedSingleLinkedList<Type, Compare> &lhs,
+                const SortedSingleLinkedList<Type, Compare> &rhs) {
+  return !(lhs < rhs);
+}
@@ -1,7 +1,34 @@
 #pragma once
 
+#include "compact-single-linked-list.h"
+#include "concurrent-single-linked-list.h"
+#include "delta-single-linked-list.h"
+#include "intrusive-single-linked-list.h"
+#include "list-views.h"
+#include "log_duration.h"
+#include "mapped-single-linked-list.h"
+#include "mpsc-single-linked-list.h"
+#include "node-pool-allocator.h"
+#include "persistent-single-linked-list.h"
+#include "rcu-single-linked-list.h"
 #include "single-linked-list.h"
+#include "small-single-linked-list.h"
+#include "sorted-single-linked-list.h"
+#include "unrolled-single-linked-list.h"
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace std::literals;
 
@@ -48,7 +75,7 @@ void AssertImpl(bool value, const std::string &expr_str, const std::string &file
 
 template <typename TestFunc>
 void RunTestImpl(const TestFunc &func, const std::string &test_name) {
-  //LOG_DURATION(test_name, std::cout);
+  LOG_DURATION(test_name, std::cout);
   func();
   std::cerr << "[OK] "s << test_name << '\n';
 }
@@ -467,8 +494,2039 @@ void Test3_ComparsionOperators() {
     }
 }
 
+void Test4_Allocators() {
+    // Список поверх арены узлов
+    {
+        int counter = 0;
+        {
+            SingleLinkedList<DeletionSpy, NodePoolAllocator<DeletionSpy>> list;
+            list.PushFront(DeletionSpy{counter});
+            list.PushFront(DeletionSpy{counter});
+            ASSERT(counter == 2);
+            ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 1);
+
+            // Очистка освобождает всю арену целиком, вызывая деструкторы элементов
+            list.Clear();
+            ASSERT(counter == 0);
+            ASSERT(list.IsEmpty());
+            ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 0);
+
+            list.PushFront(DeletionSpy{counter});
+            ASSERT(counter == 1);
+        }
+        ASSERT(counter == 0);
+    }
+
+    // Копия списка получает собственную арену
+    {
+        using PoolList = SingleLinkedList<int, NodePoolAllocator<int>>;
+        PoolList list({1, 2, 3});
+        PoolList list_copy(list);
+        ASSERT(list_copy == list);
+        ASSERT(list_copy.GetAllocator() != list.GetAllocator());
+
+        // Разделяемая арена не освобождается одним из списков
+        NodePoolAllocator<int> shared;
+        PoolList first({1, 2}, shared);
+        PoolList second({3, 4}, shared);
+        first.Clear();
+        ASSERT(shared.GetPool().GetBlockCount() == 1);
+        ASSERT((second == PoolList{3, 4}));
+    }
+
+    // Освобождение блока из нескольких узлов после неудачной вставки не
+    // мешает повторно использовать одиночные узлы
+    {
+        using ThrowingPoolList = SingleLinkedList<ThrowOnCopy, NodePoolAllocator<ThrowOnCopy>>;
+        int countdown = 100;
+        const std::vector<ThrowOnCopy> values(4, ThrowOnCopy(countdown));
+        const ThrowingPoolList source(values.begin(), values.end());
+        ThrowingPoolList list;
+        countdown = 2;
+        try {
+            list = source;
+            ASSERT(false);
+        } catch (const std::bad_alloc &) {
+        }
+        ASSERT(list.IsEmpty());
+        list.PushFront(ThrowOnCopy());
+        const size_t blocks = list.GetAllocator().GetPool().GetBlockCount();
+        for (int i = 0; i < 20000; ++i) {
+            list.PushFront(ThrowOnCopy());
+            list.PopFront();
+        }
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == blocks);
+    }
+
+    // Полиморфные аллокаторы
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        pmr::SingleLinkedList<std::string> list(&resource);
+        list.PushFront("world"s);
+        list.PushFront("hello"s);
+        ASSERT(list.GetSize() == 2u);
+        ASSERT(*list.begin() == "hello"s);
+        ASSERT(list.GetAllocator().resource() == &resource);
+    }
+}
+
+// Считает копирования и перемещения
+struct CopyMoveCounter {
+    CopyMoveCounter(int &copies, int &moves) noexcept
+        : copies_ptr(&copies), moves_ptr(&moves) {}
+    CopyMoveCounter(const CopyMoveCounter &other) noexcept
+        : copies_ptr(other.copies_ptr), moves_ptr(other.moves_ptr) {
+      ++(*copies_ptr);
+    }
+    CopyMoveCounter(CopyMoveCounter &&other) noexcept
+        : copies_ptr(other.copies_ptr), moves_ptr(other.moves_ptr) {
+      ++(*moves_ptr);
+    }
+    CopyMoveCounter &operator=(const CopyMoveCounter &rhs) = default;
+
+    int *copies_ptr = nullptr;
+    int *moves_ptr = nullptr;
+};
+
+void Test5_MoveSemantics() {
+    // Перемещающий конструктор забирает узлы
+    {
+        SingleLinkedList<int> source{1, 2, 3};
+        const auto old_begin = source.begin();
+        SingleLinkedList<int> moved(std::move(source));
+        ASSERT(moved.begin() == old_begin);
+        ASSERT(moved.GetSize() == 3u);
+        ASSERT(source.IsEmpty());
+        ASSERT(source.begin() == source.end());
+
+        // Перемещённый список остаётся пригодным к использованию
+        source.PushFront(4);
+        ASSERT((source == SingleLinkedList<int>{4}));
+    }
+
+    // Перемещающее присваивание
+    {
+        int counter = 0;
+        SingleLinkedList<DeletionSpy> receiver;
+        receiver.PushFront(DeletionSpy{counter});
+        SingleLinkedList<DeletionSpy> source;
+        source.PushFront(DeletionSpy{counter});
+        source.PushFront(DeletionSpy{counter});
+        const auto old_begin = source.begin();
+
+        receiver = std::move(source);
+        ASSERT(counter == 2);
+        ASSERT(receiver.GetSize() == 2u);
+        ASSERT(receiver.begin() == old_begin);
+        ASSERT(source.IsEmpty());
+    }
+
+    // Вставка rvalue и конструирование на месте не копируют элемент
+    {
+        int copies = 0;
+        int moves = 0;
+        SingleLinkedList<CopyMoveCounter> list;
+        list.PushFront(CopyMoveCounter(copies, moves));
+        ASSERT(copies == 0);
+        ASSERT(moves == 1);
+
+        auto &front = list.EmplaceFront(copies, moves);
+        ASSERT(copies == 0);
+        ASSERT(moves == 1);
+        ASSERT(&front == &*list.begin());
+        ASSERT(list.GetSize() == 2u);
+    }
+
+    // Обмен с пустым списком
+    {
+        SingleLinkedList<int> list{1, 2};
+        SingleLinkedList<int> empty_list;
+        list.swap(empty_list);
+        ASSERT(list.IsEmpty());
+        ASSERT((empty_list == SingleLinkedList<int>{1, 2}));
+
+        SingleLinkedList<int> receiver{3};
+        receiver = list;
+        ASSERT(receiver.IsEmpty());
+    }
+}
+
+void Test6_UnrolledList() {
+    using IntList = UnrolledSingleLinkedList<int, 4>;
+
+    // Вставка в начало через границы узлов
+    {
+        IntList list;
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        for (int i = 0; i < 10; ++i) {
+            list.PushFront(i);
+        }
+        ASSERT(list.GetSize() == 10u);
+        int expected = 9;
+        for (int value : list) {
+            ASSERT(value == expected--);
+        }
+        ASSERT(expected == -1);
+    }
+
+    // Инициализация, копирование и сравнение
+    {
+        IntList list{1, 2, 3, 4, 5, 6};
+        ASSERT(list.GetSize() == 6u);
+        ASSERT(*list.cbegin() == 1);
+
+        list.PushFront(0);
+        ASSERT((list == IntList{0, 1, 2, 3, 4, 5, 6}));
+
+        IntList list_copy(list);
+        ASSERT(list_copy == list);
+        ASSERT(list_copy.begin() != list.begin());
+
+        ASSERT((IntList{1, 2, 3} < IntList{1, 2, 3, 1}));
+        ASSERT((IntList{1, 2, 4} > IntList{1, 2, 3}));
+        ASSERT((IntList{1, 2, 3} <= IntList{1, 2, 3}));
+        ASSERT((IntList{1, 2, 3} >= IntList{1, 2, 3}));
+        ASSERT((IntList{1, 2, 3} != IntList{1, 2}));
+
+        IntList moved(std::move(list_copy));
+        ASSERT(moved == list);
+        ASSERT(list_copy.IsEmpty());
+    }
+
+    // Удаление элементов
+    {
+        int counter = 0;
+        {
+            UnrolledSingleLinkedList<DeletionSpy, 2> list;
+            for (int i = 0; i < 5; ++i) {
+                list.PushFront(DeletionSpy{counter});
+            }
+            ASSERT(counter == 5);
+            list.Clear();
+            ASSERT(counter == 0);
+            ASSERT(list.IsEmpty());
+            list.EmplaceFront(counter);
+            ASSERT(counter == 1);
+        }
+        ASSERT(counter == 0);
+    }
+
+    // Безопасное копирование
+    {
+        UnrolledSingleLinkedList<ThrowOnCopy, 2> src_list;
+        for (int i = 0; i < 3; ++i) {
+            src_list.PushFront(ThrowOnCopy{});
+        }
+        // Разрешено ровно одно копирование помеченного элемента
+        int copy_counter = 1;
+        src_list.begin()->countdown_ptr = &copy_counter;
+        auto receiver = src_list;
+        ASSERT(receiver.GetSize() == 3u);
+        ASSERT(copy_counter == 0);
+
+        try {
+            auto failed_copy = src_list;
+            ASSERT(false);
+        } catch (const std::bad_alloc &) {
+        }
+    }
+}
+
+void Test7_SortMergeUnique() {
+    using IntList = SingleLinkedList<int>;
+
+    // Сортировка перецепляет узлы, а не копирует значения
+    {
+        IntList list{5, 3, 1, 4, 2};
+        const int *const one = &*std::next(list.begin(), 2);
+        list.Sort();
+        ASSERT((list == IntList{1, 2, 3, 4, 5}));
+        ASSERT(&*list.begin() == one);
+
+        list.Sort(std::greater<>());
+        ASSERT((list == IntList{5, 4, 3, 2, 1}));
+
+        IntList empty_list;
+        empty_list.Sort();
+        ASSERT(empty_list.IsEmpty());
+    }
+
+    // Сортировка устойчива
+    {
+        using Pair = std::pair<int, int>;
+        SingleLinkedList<Pair> list{{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0, 4}};
+        list.Sort([](const Pair &lhs, const Pair &rhs) {
+            return lhs.first < rhs.first;
+        });
+        ASSERT((list == SingleLinkedList<Pair>{{0, 4}, {1, 1}, {1, 3}, {2, 0}, {2, 2}}));
+    }
+
+    // Слияние и удаление повторов
+    {
+        IntList first{1, 3, 5, 7};
+        IntList second{2, 3, 6};
+        first.Merge(second);
+        ASSERT((first == IntList{1, 2, 3, 3, 5, 6, 7}));
+        ASSERT(first.GetSize() == 7u);
+        ASSERT(second.IsEmpty());
+
+        ASSERT(first.Unique() == 1u);
+        ASSERT((first == IntList{1, 2, 3, 5, 6, 7}));
+        ASSERT(first.GetSize() == 6u);
+
+        IntList odd_even{1, 3, 2, 4, 6, 5};
+        odd_even.Unique([](int lhs, int rhs) { return lhs % 2 == rhs % 2; });
+        ASSERT((odd_even == IntList{1, 2, 5}));
+    }
+
+    // При исключении в компараторе элементы не теряются
+    {
+        IntList list{9, 8, 7, 6, 5, 4, 3, 2, 1};
+        int comparisons_left = 10;
+        try {
+            list.Sort([&comparisons_left](int lhs, int rhs) {
+                if (comparisons_left-- == 0) {
+                    throw std::runtime_error("compare failed");
+                }
+                return lhs < rhs;
+            });
+            ASSERT(false);
+        } catch (const std::runtime_error &) {
+        }
+        ASSERT(list.GetSize() == 9u);
+        std::vector<int> values(list.begin(), list.end());
+        std::sort(values.begin(), values.end());
+        ASSERT((values == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    // Параллельная сортировка
+    {
+        std::mt19937 generator(42);
+        std::vector<int> values(10000);
+        for (int &value : values) {
+            value = static_cast<int>(generator() % 1000);
+        }
+        IntList list(values.begin(), values.end());
+        ThreadPool pool(4);
+        list.Sort(pool);
+        std::sort(values.begin(), values.end());
+        ASSERT(list.GetSize() == values.size());
+        ASSERT(std::equal(list.begin(), list.end(), values.begin()));
+    }
+}
+
+void Test8_BulkConstruction() {
+    using IntList = SingleLinkedList<int>;
+
+    // Конструирование из диапазона
+    {
+        const std::vector<int> values{1, 2, 3, 4};
+        IntList list(values.begin(), values.end());
+        ASSERT(list.GetSize() == 4u);
+        ASSERT(std::equal(list.begin(), list.end(), values.begin()));
+
+        std::istringstream input("5 6 7");
+        IntList from_stream(std::istream_iterator<int>(input),
+                            std::istream_iterator<int>{});
+        ASSERT((from_stream == IntList{5, 6, 7}));
+    }
+
+    // Assign переиспользует существующие узлы
+    {
+        IntList list{1, 2, 3};
+        const int *const first = &*list.begin();
+        const std::vector<int> longer{4, 5, 6, 7, 8};
+        list.Assign(longer.begin(), longer.end());
+        ASSERT((list == IntList{4, 5, 6, 7, 8}));
+        ASSERT(list.GetSize() == 5u);
+        ASSERT(&*list.begin() == first);
+
+        list.Assign({9, 10});
+        ASSERT((list == IntList{9, 10}));
+        ASSERT(list.GetSize() == 2u);
+        ASSERT(&*list.begin() == first);
+
+        list.Assign(longer.end(), longer.end());
+        ASSERT(list.IsEmpty());
+    }
+
+    // Копирующее присваивание переиспользует узлы приёмника
+    {
+        IntList receiver{1, 2};
+        const int *const first = &*receiver.begin();
+        const IntList source{3, 4, 5};
+        receiver = source;
+        ASSERT(receiver == source);
+        ASSERT(&*receiver.begin() == first);
+
+        const IntList shorter{6};
+        receiver = shorter;
+        ASSERT(receiver == shorter);
+        ASSERT(receiver.GetSize() == 1u);
+        ASSERT(&*receiver.begin() == first);
+    }
+
+    // Арена выделяет узлы копии одним непрерывным блоком
+    {
+        using PoolList = SingleLinkedList<int, NodePoolAllocator<int>>;
+        const PoolList source{1, 2, 3, 4, 5};
+        PoolList copy(source);
+        ASSERT(copy == source);
+        ASSERT(copy.GetAllocator().GetPool().GetBlockCount() == 1u);
+        const int *previous = nullptr;
+        for (const int &value : copy) {
+            ASSERT(previous == nullptr ||
+                   reinterpret_cast<const char *>(&value) >
+                       reinterpret_cast<const char *>(previous));
+            previous = &value;
+        }
+    }
+}
+
+void Test9_ConcurrentStack() {
+    // Однопоточная семантика LIFO
+    {
+        ConcurrentSingleLinkedList<std::string> stack;
+        ASSERT(stack.IsEmpty());
+        ASSERT(!stack.TryPopFront().has_value());
+        stack.PushFront("one"s);
+        stack.PushFront("two"s);
+        stack.EmplaceFront(3, 'x');
+        ASSERT(stack.GetSize() == 3u);
+        ASSERT(stack.TryPopFront() == "xxx"s);
+
+        const auto rest = stack.PopAll();
+        ASSERT((rest == SingleLinkedList<std::string>{"two"s, "one"s}));
+        ASSERT(stack.IsEmpty());
+        ASSERT(stack.GetSize() == 0u);
+    }
+
+    // Узлы, оставшиеся в стеке, удаляются вместе с ним
+    {
+        int counter = 0;
+        {
+            ConcurrentSingleLinkedList<DeletionSpy> stack;
+            stack.PushFront(DeletionSpy{counter});
+            stack.PushFront(DeletionSpy{counter});
+            ASSERT(stack.TryPopFront().has_value());
+        }
+        ASSERT(counter == 0);
+    }
+
+    // Нагрузочный тест: каждый элемент извлекается ровно один раз
+    {
+        constexpr int kProducers = 4;
+        constexpr int kConsumers = 4;
+        constexpr int kItemsPerProducer = 50000;
+        ConcurrentSingleLinkedList<int> stack;
+        std::atomic<int> producers_left{kProducers};
+        // Размер не превышает числа вставленных элементов, в том числе не
+        // уходит ниже нуля, пока вставка и извлечение идут одновременно
+        std::atomic<bool> size_out_of_range{false};
+        std::vector<std::vector<int>> popped(kConsumers);
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < kProducers; ++p) {
+            threads.emplace_back([&stack, &producers_left, p] {
+                for (int i = 0; i < kItemsPerProducer; ++i) {
+                    stack.PushFront(p * kItemsPerProducer + i);
+                }
+                --producers_left;
+            });
+        }
+        for (int c = 0; c < kConsumers; ++c) {
+            threads.emplace_back([&stack, &producers_left, &popped, &size_out_of_range, c] {
+                auto &mine = popped[c];
+                while (producers_left > 0 || !stack.IsEmpty()) {
+                    if (stack.GetSize() > size_t{kProducers} * kItemsPerProducer) {
+                        size_out_of_range = true;
+                    }
+                    if (c == 0 && mine.size() % 1000 == 999) {
+                        for (int value : stack.PopAll()) {
+                            mine.push_back(value);
+                        }
+                    }
+                    if (auto value = stack.TryPopFront()) {
+                        mine.push_back(*value);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        std::vector<int> all;
+        for (const auto &part : popped) {
+            all.insert(all.end(), part.begin(), part.end());
+        }
+        std::sort(all.begin(), all.end());
+        ASSERT(!size_out_of_range);
+        ASSERT(stack.GetSize() == 0u);
+        ASSERT(all.size() == static_cast<size_t>(kProducers * kItemsPerProducer));
+        for (size_t i = 0; i < all.size(); ++i) {
+            ASSERT(all[i] == static_cast<int>(i));
+        }
+        ASSERT(stack.IsEmpty());
+    }
+}
+
+void Test10_Instrumentation() {
+    // Выключенная инструментация не увеличивает итераторы
+    static_assert(sizeof(SingleLinkedList<int>::Iterator) == sizeof(void *));
+
+    using TracedList =
+        SingleLinkedList<int, std::allocator<int>, ListInstrumentation>;
+
+    // Счётчики выделений, шагов итератора и времени операций
+    {
+        TracedList list;
+        list.PushFront(1);
+        list.PushFront(2);
+        list.EmplaceFront(3);
+
+        auto stats = list.GetStats();
+        ASSERT(stats.allocations == 3u);
+        ASSERT(stats.deallocations == 0u);
+        ASSERT(stats.bytes_held >= 3 * (sizeof(int) + sizeof(void *)));
+        ASSERT(stats[ListOperation::kPushFront].calls == 3u);
+
+        int sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        ASSERT(sum == 6);
+        ASSERT(list.GetStats().iterator_increments == 3u);
+
+        list.Sort();
+        list.Clear();
+        stats = list.GetStats();
+        ASSERT(stats.deallocations == 3u);
+        ASSERT(stats.bytes_held == 0u);
+        ASSERT(stats[ListOperation::kSort].calls == 1u);
+        ASSERT(stats[ListOperation::kClear].calls == 1u);
+        ASSERT(stats[ListOperation::kClear].max_ns <=
+               stats[ListOperation::kClear].total_ns);
+
+        list.ResetStats();
+        ASSERT(list.GetStats().allocations == 0u);
+    }
+
+    // Копирование учитывается в статистике нового списка
+    {
+        const TracedList source{1, 2, 3, 4};
+        TracedList copy(source);
+        ASSERT(copy.GetStats().allocations == 4u);
+        ASSERT(copy.GetStats()[ListOperation::kCopy].calls == 1u);
+
+        TracedList receiver{5};
+        receiver = source;
+        ASSERT(receiver.GetStats().allocations == 1u + 3u);
+        ASSERT(receiver == copy);
+    }
+
+    // Для арены учитываются все её блоки
+    {
+        SingleLinkedList<int, NodePoolAllocator<int>, ListInstrumentation> list;
+        list.PushFront(1);
+        ASSERT(list.GetStats().bytes_held ==
+               list.GetAllocator().GetPool().GetReservedBytes());
+    }
+}
+
+void Test11_PrefetchKernels() {
+    SingleLinkedList<int> list{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const auto &const_list = list;
+
+    int sum = 0;
+    const_list.ForEach([&sum](int value) { sum += value; });
+    ASSERT(sum == 55);
+
+    list.ForEach<1>([](int &value) { value *= 2; });
+    ASSERT(const_list.Accumulate(0) == 110);
+    ASSERT(const_list.Accumulate<16>(1LL, std::multiplies<>()) ==
+           3715891200LL);
+
+    auto found = list.FindIf([](int value) { return value > 7; });
+    ASSERT(found != list.end());
+    ASSERT(*found == 8);
+    *found = 0;
+    ASSERT(const_list.FindIf<0>([](int value) { return value == 0; }) ==
+           std::next(list.cbegin(), 3));
+    ASSERT(const_list.FindIf([](int value) { return value < 0; }) ==
+           const_list.end());
+
+    ASSERT(const_list.CountIf([](int value) { return value % 4 == 0; }) == 5u);
+
+    const SingleLinkedList<int> empty_list;
+    ASSERT(empty_list.Accumulate(7) == 7);
+    ASSERT(empty_list.CountIf([](int) { return true; }) == 0u);
+}
+
+void Test12_DeferredDestruction() {
+    BackgroundReclaimer reclaimer;
+    int counter = 0;
+
+    // Clear отцепляет цепочку сразу, а элементы удаляются в фоне
+    {
+        SingleLinkedList<DeletionSpy> list;
+        list.SetReclaimer(&reclaimer);
+        list.PushFront(DeletionSpy{counter});
+        list.PushFront(DeletionSpy{counter});
+        ASSERT(counter == 2);
+
+        list.Clear();
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        reclaimer.Flush();
+        ASSERT(counter == 0);
+        ASSERT(reclaimer.GetPendingCount() == 0u);
+
+        list.PushFront(DeletionSpy{counter});
+        ASSERT(counter == 1);
+    }
+    reclaimer.Flush();
+    ASSERT(counter == 0);
+
+    // Отложенное освобождение большого списка в деструкторе
+    {
+        auto list = std::make_unique<SingleLinkedList<int>>();
+        list->SetReclaimer(&reclaimer);
+        for (int i = 0; i < 100000; ++i) {
+            list->PushFront(i);
+        }
+        list.reset();
+        reclaimer.Flush();
+        ASSERT(reclaimer.GetPendingCount() == 0u);
+    }
+
+    // Без reclaimer освобождение выполняется синхронно
+    {
+        SingleLinkedList<DeletionSpy> list;
+        list.PushFront(DeletionSpy{counter});
+        list.SetReclaimer(&reclaimer);
+        list.SetReclaimer(nullptr);
+        list.Clear();
+        ASSERT(counter == 0);
+    }
+}
+
+void Test13_CompactList() {
+    using IntList = CompactSingleLinkedList<int>;
+
+    // Вставка, обход и сравнение
+    {
+        IntList list;
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        list.PushFront(3);
+        list.PushFront(2);
+        list.PushFront(1);
+        ASSERT(list.GetSize() == 3u);
+        ASSERT((list == IntList{1, 2, 3}));
+        ASSERT((list < IntList{1, 2, 4}));
+        ASSERT((list >= IntList{1, 2, 3}));
+        ASSERT((list != IntList{1, 2}));
+
+        *list.begin() = 0;
+        IntList::ConstIterator const_it = list.begin();
+        ASSERT(*const_it == 0);
+        ASSERT(++const_it == std::next(list.cbegin()));
+    }
+
+    // Освободившиеся ячейки переиспользуются
+    {
+        IntList list{1, 2, 3, 4};
+        const size_t capacity = list.GetCapacity();
+        list.PopFront();
+        list.PopFront();
+        ASSERT((list == IntList{3, 4}));
+        list.PushFront(20);
+        list.PushFront(10);
+        ASSERT((list == IntList{10, 20, 3, 4}));
+        ASSERT(list.GetCapacity() == capacity);
+
+        IntList copy = list;
+        ASSERT(copy == list);
+        list.Clear();
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        ASSERT(copy.GetSize() == 4u);
+
+        swap(list, copy);
+        ASSERT((list == IntList{10, 20, 3, 4}));
+        ASSERT(copy.IsEmpty());
+    }
+
+    // Список, из которого переместили элементы, пуст и пригоден к работе
+    {
+        IntList list{1, 2, 3};
+        IntList moved(std::move(list));
+        ASSERT((moved == IntList{1, 2, 3}));
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        list.PushFront(7);
+        ASSERT((list == IntList{7}));
+
+        IntList target{4, 5};
+        target = std::move(moved);
+        ASSERT((target == IntList{1, 2, 3}));
+        ASSERT(moved.IsEmpty());
+        moved.PushFront(8);
+        ASSERT((moved == IntList{8}));
+    }
+}
+
+void Test14_TailAndSplice() {
+    using IntList = SingleLinkedList<int>;
+
+    // Вставка в конец и удаление из начала поддерживают хвост
+    {
+        IntList list;
+        list.PushBack(2);
+        list.PushFront(1);
+        list.PushBack(3);
+        ASSERT(list.EmplaceBack(4) == 4);
+        ASSERT((list == IntList{1, 2, 3, 4}));
+
+        list.PopFront();
+        list.PopFront();
+        list.PopFront();
+        list.PopFront();
+        ASSERT(list.IsEmpty());
+        list.PushBack(5);
+        ASSERT((list == IntList{5}));
+
+        list.Clear();
+        list.PushBack(6);
+        ASSERT((list == IntList{6}));
+    }
+
+    // Вставка и удаление после позиции
+    {
+        IntList list{1, 3};
+        auto it = list.InsertAfter(list.begin(), 2);
+        ASSERT(*it == 2);
+        list.EmplaceAfter(std::next(list.begin(), 2), 4);
+        list.InsertAfter(list.before_begin(), 0);
+        ASSERT((list == IntList{0, 1, 2, 3, 4}));
+
+        ASSERT(list.EraseAfter(std::next(list.begin(), 3)) == list.end());
+        list.PushBack(5);
+        ASSERT((list == IntList{0, 1, 2, 3, 5}));
+    }
+
+    // Перенос всего списка и конкатенация без выделения памяти
+    {
+        IntList list{1, 4};
+        IntList other{2, 3};
+        list.SpliceAfter(list.begin(), other);
+        ASSERT(other.IsEmpty());
+        ASSERT((list == IntList{1, 2, 3, 4}));
+
+        other.PushBack(10);
+        ASSERT((other == IntList{10}));
+
+        list.Append(IntList{5, 6});
+        list.Append(IntList{});
+        list.PushBack(7);
+        ASSERT(list.GetSize() == 7u);
+        ASSERT((list == IntList{1, 2, 3, 4, 5, 6, 7}));
+
+        IntList empty;
+        empty.Append(std::move(list));
+        empty.PushBack(8);
+        ASSERT((empty == IntList{1, 2, 3, 4, 5, 6, 7, 8}));
+        ASSERT(list.IsEmpty());
+    }
+
+    // Перенос одного элемента и интервала, в том числе последнего узла
+    {
+        IntList list{1, 2};
+        IntList other{10, 20, 30, 40};
+        list.SpliceAfter(list.before_begin(), other, std::next(other.begin(), 2));
+        ASSERT((list == IntList{40, 1, 2}));
+        other.PushBack(50);
+        ASSERT((other == IntList{10, 20, 30, 50}));
+
+        list.SpliceAfter(std::next(list.begin(), 2), other, other.before_begin(),
+                         std::next(other.begin(), 2));
+        ASSERT((list == IntList{40, 1, 2, 10, 20}));
+        ASSERT((other == IntList{30, 50}));
+        list.PushBack(60);
+        ASSERT(list.GetSize() == 6u);
+        ASSERT(other.GetSize() == 2u);
+
+        // Перестановка внутри одного списка
+        list.SpliceAfter(list.before_begin(), list, std::next(list.begin(), 4));
+        ASSERT((list == IntList{60, 40, 1, 2, 10, 20}));
+        list.PushBack(70);
+        ASSERT(list.GetSize() == 7u);
+    }
+
+    // Хвост остаётся верным после сортировки, слияния и Unique
+    {
+        IntList list{3, 1, 2};
+        list.Sort();
+        list.PushBack(4);
+        ASSERT((list == IntList{1, 2, 3, 4}));
+
+        IntList other{0, 5, 6};
+        list.Merge(other);
+        list.PushBack(7);
+        ASSERT((list == IntList{0, 1, 2, 3, 4, 5, 6, 7}));
+
+        IntList dups{1, 1, 2, 2};
+        dups.Unique();
+        dups.PushBack(3);
+        ASSERT((dups == IntList{1, 2, 3}));
+
+        IntList copy;
+        copy = dups;
+        copy.PushBack(4);
+        ASSERT((copy == IntList{1, 2, 3, 4}));
+        copy.Assign({9});
+        copy.PushBack(10);
+        ASSERT((copy == IntList{9, 10}));
+    }
+}
+
+void Test15_SmallList() {
+    using IntList = SmallSingleLinkedList<int, 4>;
+
+    // Первые K элементов не выделяют память в куче
+    {
+        IntList list;
+        ASSERT(list.IsEmpty());
+        ASSERT(list.begin() == list.end());
+        for (int i = 4; i > 0; --i) {
+            list.PushFront(i);
+        }
+        ASSERT(list.GetHeapSize() == 0u);
+        ASSERT((list == IntList{1, 2, 3, 4}));
+
+        list.PushFront(0);
+        ASSERT(list.GetHeapSize() == 1u);
+        ASSERT(list.GetSize() == 5u);
+        ASSERT((list > IntList{0, 1, 2}));
+        ASSERT((list != IntList{1, 2, 3, 4}));
+
+        list.PopFront();
+        list.PopFront();
+        list.PushFront(10);
+        ASSERT(list.GetHeapSize() == 0u);
+        ASSERT((list == IntList{10, 2, 3, 4}));
+    }
+
+    // Копирование, перемещение и обмен смешанных списков
+    {
+        using StringList = SmallSingleLinkedList<std::string, 2>;
+        StringList small{"a"};
+        StringList big{"x", "y", "z", "w"};
+        ASSERT(big.GetHeapSize() == 2u);
+
+        StringList copy = big;
+        ASSERT(copy == big);
+        ASSERT(copy.GetHeapSize() == 2u);
+
+        swap(small, big);
+        ASSERT((small == StringList{"x", "y", "z", "w"}));
+        ASSERT((big == StringList{"a"}));
+
+        StringList moved = std::move(small);
+        ASSERT(small.IsEmpty());
+        ASSERT(moved == copy);
+        moved.PopFront();
+        moved.PushFront("v");
+        ASSERT((moved == StringList{"v", "y", "z", "w"}));
+        ASSERT(moved.GetHeapSize() == 2u);
+
+        big = moved;
+        ASSERT(big == moved);
+        moved = std::move(big);
+        ASSERT(big.IsEmpty());
+        ASSERT(moved.GetSize() == 4u);
+    }
+
+    // Все элементы удаляются ровно один раз
+    {
+        int counter = 0;
+        {
+            SmallSingleLinkedList<DeletionSpy, 2> list;
+            for (int i = 0; i < 5; ++i) {
+                list.EmplaceFront(counter);
+            }
+            ASSERT(counter == 5);
+            auto other = list;
+            ASSERT(counter == 10);
+            list = std::move(other);
+            ASSERT(counter == 5);
+        }
+        ASSERT(counter == 0);
+    }
+
+    // Встроенные элементы типа, перемещение которого может бросить
+    // исключение, копируются; неудачный перенос не меняет источник
+    {
+        using ThrowingList = SmallSingleLinkedList<ThrowOnCopy, 2>;
+        static_assert(!ThrowingList::kNothrowMove);
+        int countdown = 100;
+        ThrowingList list;
+        for (int i = 0; i < 3; ++i) {
+            list.EmplaceFront(countdown);
+        }
+        ThrowingList copy = list;
+        ThrowingList moved = std::move(list);
+        ASSERT(list.IsEmpty());
+        ASSERT(moved.GetSize() == 3u);
+        swap(moved, list);
+        ASSERT(moved.IsEmpty() && list.GetSize() == 3u);
+        moved = copy;
+        ASSERT(moved.GetSize() == 3u);
+
+        countdown = 1;
+        try {
+            ThrowingList failed = std::move(copy);
+            ASSERT(false);
+        } catch (const std::bad_alloc &) {
+        }
+        ASSERT(copy.GetSize() == 3u);
+        ASSERT(std::all_of(copy.begin(), copy.end(), [&countdown](const ThrowOnCopy &value) {
+            return value.GetCountDownPtr() == &countdown;
+        }));
+    }
+}
+
+void Test16_Compact() {
+    // Узлы перекладываются в порядке обхода без изменения содержимого
+    {
+        SingleLinkedList<std::string> list;
+        SingleLinkedList<std::string> expected;
+        std::vector<std::unique_ptr<int>> noise;
+        for (int i = 0; i < 2000; ++i) {
+            list.PushFront(std::to_string(i));
+            noise.push_back(std::make_unique<int>(i));
+        }
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (std::next(it) != list.end()) {
+                list.EraseAfter(it);
+            }
+        }
+        for (const auto &value : list) {
+            expected.PushBack(value);
+        }
+        noise.clear();
+
+        const CompactionReport report = list.Compact();
+        ASSERT(list == expected);
+        ASSERT(list.GetSize() == 1000u);
+        ASSERT(report.page_visits_after <= report.page_visits_before);
+        list.PushBack("tail");
+        ASSERT(list.GetSize() == 1001u);
+
+        SingleLinkedList<std::string> empty;
+        ASSERT(empty.Compact().page_visits_after == 0u);
+        ASSERT(empty.GetFragmentation() == 1.0);
+    }
+
+    // Единоличная арена заменяется одним блоком, память старой освобождается
+    {
+        using PoolList = SingleLinkedList<int, NodePoolAllocator<int>>;
+        PoolList list;
+        {
+            // Узлы второго списка из той же арены разносят узлы list
+            PoolList noise(list.GetAllocator());
+            for (int i = 0; i < 5000; ++i) {
+                list.PushFront(i);
+                for (int j = 0; j < 15; ++j) {
+                    noise.PushFront(j);
+                }
+            }
+        }
+        ASSERT(list.GetFragmentation() > PoolList::kDefaultFragmentationThreshold);
+        const auto report = list.CompactIfFragmented();
+        ASSERT(report.has_value());
+        ASSERT(report->GetReclaimedBytes() > 0u);
+        ASSERT(report->GetReclaimedPages() > 0u);
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 1u);
+        ASSERT(list.GetFragmentation() <= 2.0);
+        ASSERT(!list.CompactIfFragmented().has_value());
+
+        int expected = 4999;
+        for (int value : list) {
+            ASSERT(value == expected--);
+        }
+    }
+}
+
+void Test17_MappedList() {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "single-linked-list-test.bin")
+            .string();
+
+    // Сохранённый список читается из отображения в исходном порядке
+    {
+        struct Point {
+            int16_t x;
+            double y;
+        };
+        SingleLinkedList<Point> points;
+        for (int i = 0; i < 1000; ++i) {
+            points.PushBack(Point{static_cast<int16_t>(i), i * 0.5});
+        }
+        SaveSingleLinkedList(points, path);
+
+        MappedSingleLinkedList<Point> mapped(path);
+        ASSERT(mapped.GetSize() == 1000u);
+        ASSERT(mapped.Validate());
+        ASSERT(std::equal(mapped.begin(), mapped.end(), points.begin(),
+                          [](const Point &lhs, const Point &rhs) {
+                              return lhs.x == rhs.x && lhs.y == rhs.y;
+                          }));
+        ASSERT(std::next(mapped.begin(), 999)->y == 499.5);
+
+        // Файл другого типа не принимается
+        bool thrown = false;
+        try {
+            MappedSingleLinkedList<int> wrong(path);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    // Сравнение, перемещение и загрузка обратно в SingleLinkedList
+    {
+        const SingleLinkedList<int> list{1, 2, 3};
+        SaveSingleLinkedList(list, path);
+        MappedSingleLinkedList<int> first(path);
+        SaveSingleLinkedList(SingleLinkedList<int>{1, 2, 4}, path + ".2");
+        MappedSingleLinkedList<int> second(path + ".2");
+        ASSERT(first != second);
+        ASSERT(first < second);
+        ASSERT(first == first);
+
+        MappedSingleLinkedList<int> moved(std::move(second));
+        ASSERT(second.IsEmpty());
+        ASSERT(moved > first);
+
+        const SingleLinkedList<int> loaded(first.begin(), first.end());
+        ASSERT(loaded == list);
+
+        SaveSingleLinkedList(SingleLinkedList<int>{}, path);
+        MappedSingleLinkedList<int> empty(path);
+        ASSERT(empty.IsEmpty());
+        ASSERT(empty.begin() == empty.end());
+        ASSERT(empty.Validate());
+    }
+    std::remove(path.c_str());
+    std::remove((path + ".2").c_str());
+
+    bool thrown = false;
+    try {
+        MappedSingleLinkedList<int> missing(path);
+    } catch (const std::system_error &) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void Test18_PersistentList() {
+    using IntList = PersistentSingleLinkedList<int>;
+
+    // Копия разделяет узлы, изменения головы не видны другим копиям
+    {
+        IntList original{2, 3};
+        IntList copy = original;
+        ASSERT(&*copy.begin() == &*original.begin());
+
+        copy.PushFront(1);
+        ASSERT((copy == IntList{1, 2, 3}));
+        ASSERT((original == IntList{2, 3}));
+        ASSERT(&*std::next(copy.begin()) == &*original.begin());
+
+        original.PopFront();
+        original.PushFront(20);
+        ASSERT((original == IntList{20, 3}));
+        ASSERT((copy == IntList{1, 2, 3}));
+        ASSERT(copy.Front() == 1);
+
+        const IntList pushed = copy.PushedFront(0);
+        ASSERT((pushed == IntList{0, 1, 2, 3}));
+        ASSERT(copy.GetSize() == 3u);
+        ASSERT(pushed < copy);
+
+        IntList moved = std::move(copy);
+        ASSERT(copy.IsEmpty());
+        copy = moved;
+        ASSERT(copy == moved);
+        moved.Clear();
+        ASSERT((copy == IntList{1, 2, 3}));
+    }
+
+    // Узел удаляется, когда его не использует ни одна копия
+    {
+        int counter = 0;
+        {
+            PersistentSingleLinkedList<DeletionSpy> list;
+            list.EmplaceFront(counter);
+            list.EmplaceFront(counter);
+            auto snapshot = list;
+            list.PopFront();
+            list.PopFront();
+            ASSERT(counter == 2);
+            snapshot.PopFront();
+            ASSERT(counter == 1);
+        }
+        ASSERT(counter == 0);
+    }
+
+    // Длинный общий хвост освобождается без рекурсии, в том числе в других потоках
+    {
+        std::vector<int> values(1000000);
+        std::iota(values.begin(), values.end(), 0);
+        auto list = std::make_unique<IntList>(values.begin(), values.end());
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([snapshot = *list]() mutable {
+                ASSERT(snapshot.GetSize() == 1000000u);
+                snapshot.PushFront(-1);
+                snapshot.Clear();
+            });
+        }
+        list.reset();
+        for (auto &reader : readers) {
+            reader.join();
+        }
+    }
+}
+
+void Test19_ParallelAlgorithms() {
+    ThreadPool pool(4);
+    ThreadPool single(1);
+    std::vector<int> values(100000);
+    std::iota(values.begin(), values.end(), 1);
+    SingleLinkedList<int> list(values.begin(), values.end());
+
+    // Каждый элемент обрабатывается ровно один раз
+    {
+        std::atomic<long long> sum{0};
+        std::as_const(list).ForEach(pool, [&sum](int value) { sum += value; });
+        ASSERT(sum == 5000050000LL);
+
+        list.Transform(pool, [](int value) { return value * 2; });
+        ASSERT(list.Accumulate(0LL) == 10000100000LL);
+        list.ForEach(pool, [](int &value) { value /= 2; });
+        ASSERT(std::equal(list.begin(), list.end(), values.begin()));
+
+        SingleLinkedList<int> empty;
+        ASSERT(empty.Reduce(pool, 7) == 7);
+        ASSERT((SingleLinkedList<int>{1, 2, 3}.Reduce(pool, 10) == 16));
+    }
+
+    // Порядок свёртки не зависит от числа потоков
+    {
+        ASSERT(list.Reduce(pool, 0LL) == 5000050000LL);
+        // Неассоциативная операция с плавающей точкой
+        const auto op = [](double acc, double value) { return acc * 0.999 + value; };
+        const double parallel = list.Reduce(pool, 0.0, op);
+        const double sequential = list.Reduce(single, 0.0, op);
+        ASSERT(parallel == sequential);
+
+        SingleLinkedList<std::string> words;
+        for (int i = 0; i < 5000; ++i) {
+            words.PushBack(std::to_string(i % 10));
+        }
+        const std::string joined = words.Reduce(pool, std::string(">"));
+        ASSERT(joined.size() == 5001u);
+        ASSERT(joined.substr(0, 12) == ">01234567890");
+        ASSERT(joined.substr(4991) == "0123456789");
+    }
+
+    // Исключение из func пробрасывается после завершения всех потоков
+    {
+        bool thrown = false;
+        try {
+            list.ForEach(pool, [](int value) {
+                if (value == 77777) {
+                    throw std::runtime_error("bad value");
+                }
+            });
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+        ASSERT(list.Reduce(pool, 0LL) == 5000050000LL);
+    }
+}
+
+void Test20_PositionalIndex() {
+    using IntList = SingleLinkedList<int>;
+    const auto check_all = [](const IntList &list) {
+        std::vector<int> expected(list.begin(), list.end());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (list.At(i) != expected[i]) {
+                return false;
+            }
+        }
+        return list.IteratorAt(expected.size()) == list.end();
+    };
+
+    // Без индекса позиционный доступ проходит узлы подряд
+    {
+        IntList list{0, 1, 2, 3};
+        ASSERT(!list.HasPositionalIndex());
+        ASSERT(list.At(2) == 2);
+        ASSERT(*list.Advance(list.begin(), 3) == 3);
+        bool thrown = false;
+        try {
+            [[maybe_unused]] int value = list.At(4);
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    // PushFront и PopFront поддерживают индекс, остальные изменения его перестраивают
+    {
+        IntList list;
+        list.EnablePositionalIndex(4);
+        for (int i = 0; i < 50; ++i) {
+            list.PushFront(i);
+            ASSERT(list.At(0) == i);
+        }
+        ASSERT(check_all(list));
+        for (int i = 0; i < 7; ++i) {
+            list.PopFront();
+        }
+        ASSERT(list.At(0) == 42);
+        ASSERT(check_all(list));
+
+        list.PushBack(-1);
+        list.EraseAfter(list.IteratorAt(10));
+        list.InsertAfter(list.IteratorAt(20), 100);
+        list.InsertAfter(list.before_begin(), 200);
+        ASSERT(check_all(list));
+        list.Sort();
+        ASSERT(check_all(list));
+        list.Unique();
+        list.Compact();
+        ASSERT(check_all(list));
+        IntList other{7, 8, 9};
+        list.Append(std::move(other));
+        ASSERT(list.At(list.GetSize() - 1) == 9);
+        ASSERT(check_all(list));
+
+        list.Clear();
+        ASSERT(list.IteratorAt(0) == list.end());
+        list.PushFront(5);
+        ASSERT(list.At(0) == 5);
+        list.DisablePositionalIndex();
+        ASSERT(list.At(0) == 5);
+    }
+
+    // Advance находит позицию итератора по индексу
+    {
+        std::vector<int> values(100000);
+        std::iota(values.begin(), values.end(), 0);
+        IntList list(values.begin(), values.end());
+        list.EnablePositionalIndex();
+        list.RebuildPositionalIndex();
+        const IntList &const_list = list;
+        ASSERT(const_list.At(99999) == 99999);
+        ASSERT(*const_list.Advance(const_list.IteratorAt(12345), 50000) == 62345);
+        ASSERT(*list.Advance(list.begin(), 70000) == 70000);
+        ASSERT(*list.Advance(list.before_begin(), 1) == 0);
+        ASSERT(list.Advance(list.IteratorAt(99990), 10) == list.end());
+        ASSERT(*list.Advance(list.IteratorAt(99950), 49) == 99999);
+        list.At(500) = -500;
+        ASSERT(*std::next(list.begin(), 500) == -500);
+    }
+
+    // Advance из середины списка после вставок и удалений в начале,
+    // поддерживающих индекс без перестроения
+    {
+        std::vector<int> values(1000);
+        std::iota(values.begin(), values.end(), 0);
+        IntList list(values.begin(), values.end());
+        list.EnablePositionalIndex(8);
+        list.RebuildPositionalIndex();
+        for (int i = 1; i <= 20; ++i) {
+            list.PushFront(-i);
+        }
+        for (int i = 0; i < 5; ++i) {
+            list.PopFront();
+        }
+        // Список: -15 ... -1, 0 ... 999
+        for (size_t from = 0; from < 40; ++from) {
+            for (size_t n : {17u, 100u, 500u}) {
+                const auto it = list.Advance(list.IteratorAt(from), n);
+                ASSERT(*it == static_cast<int>(from + n) - 15);
+            }
+        }
+        ASSERT(list.Advance(list.IteratorAt(30), list.GetSize() - 30) == list.end());
+    }
+
+    // Константный доступ не перестраивает устаревший индекс, поэтому
+    // безопасен из нескольких потоков одновременно
+    {
+        std::vector<int> values(4096);
+        std::iota(values.begin(), values.end(), 0);
+        IntList list(values.begin(), values.end());
+        list.EnablePositionalIndex(16);
+        const IntList &const_list = list;
+        std::atomic<bool> mismatch = false;
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&const_list, &mismatch, t] {
+                for (int i = t; i < 4096; i += 97) {
+                    if (const_list.At(i) != i ||
+                        *const_list.Advance(const_list.begin(), i) != i) {
+                        mismatch = true;
+                    }
+                }
+            });
+        }
+        for (auto &thread : readers) {
+            thread.join();
+        }
+        ASSERT(!mismatch);
+        ASSERT(list.At(4000) == 4000);
+        ASSERT(check_all(list));
+    }
+}
+
+void Test21_SortedList() {
+    using IntList = SortedSingleLinkedList<int>;
+
+    // Порядок совпадает с std::multiset при случайных вставках и удалениях
+    {
+        IntList list;
+        std::multiset<int> expected;
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> distribution(0, 999);
+        for (int i = 0; i < 5000; ++i) {
+            const int value = distribution(generator);
+            ASSERT(*list.Insert(value) == value);
+            expected.insert(value);
+        }
+        for (int i = 0; i < 500; ++i) {
+            const int value = distribution(generator);
+            ASSERT(list.Erase(value) == expected.erase(value));
+        }
+        ASSERT(list.GetSize() == expected.size());
+        ASSERT(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+        for (int value = -1; value <= 1000; ++value) {
+            const auto lower = list.LowerBound(value);
+            const auto expected_lower = expected.lower_bound(value);
+            ASSERT((lower == list.end()) == (expected_lower == expected.end()));
+            ASSERT(lower == list.end() || *lower == *expected_lower);
+            ASSERT(list.Contains(value) == (expected.count(value) > 0));
+        }
+        ASSERT(list.Find(-5) == list.end());
+
+        list.Clear();
+        ASSERT(list.IsEmpty());
+        ASSERT(list.Erase(1) == 0u);
+        list.Insert(3);
+        ASSERT((list == IntList{3}));
+    }
+
+    // Эквивалентные элементы хранятся в порядке вставки
+    {
+        using Pair = std::pair<int, int>;
+        const auto by_first = [](const Pair &lhs, const Pair &rhs) {
+            return lhs.first < rhs.first;
+        };
+        SortedSingleLinkedList<Pair, decltype(by_first)> list(by_first);
+        list.Insert({2, 0});
+        list.Insert({1, 0});
+        list.Insert({2, 1});
+        list.Insert({2, 2});
+        ASSERT(list.Find({2, -1})->second == 0);
+        ASSERT(list.UpperBound({1, 0})->second == 0);
+        ASSERT(std::next(list.LowerBound({2, 9}), 2)->second == 2);
+        ASSERT(list.Erase({2, 5}) == 3u);
+        ASSERT(list.GetSize() == 1u);
+    }
+
+    // Копирование, перемещение, обмен и сравнения
+    {
+        const IntList original{5, 1, 4, 2, 3};
+        ASSERT((original == IntList{1, 2, 3, 4, 5}));
+        IntList copy = original;
+        ASSERT(copy == original);
+        copy.Insert(0);
+        ASSERT(copy < original);
+        ASSERT((original > IntList{1, 2, 3}));
+
+        IntList moved = std::move(copy);
+        ASSERT(copy.IsEmpty());
+        ASSERT(moved.GetSize() == 6u);
+        swap(moved, copy);
+        ASSERT(moved.IsEmpty());
+        ASSERT(*copy.begin() == 0);
+        moved = copy;
+        ASSERT(moved == copy);
+
+        SortedSingleLinkedList<int, std::greater<>> descending{1, 3, 2};
+        ASSERT(*descending.begin() == 3);
+        ASSERT(*descending.LowerBound(2) == 2);
+    }
+}
+
+void Test22_LazyViews() {
+    using IntList = SingleLinkedList<int>;
+
+#if __cplusplus >= 202002L
+    static_assert(std::ranges::forward_range<IntList>);
+    static_assert(std::ranges::forward_range<const IntList>);
+    static_assert(std::sentinel_for<IntList::ConstIterator, IntList::Iterator>);
+    static_assert(std::ranges::forward_range<
+                  decltype(list_views::Transform(std::declval<IntList &>(),
+                                                 [](int value) { return value; }))>);
+#endif
+
+    // Стадии вычисляются лениво и не трогают исходный список
+    {
+        IntList list{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        size_t calls = 0;
+        auto view = list | list_views::Filter([&calls](int value) {
+                        ++calls;
+                        return value % 2 == 0;
+                    }) |
+                    list_views::Transform([](int value) { return value * value; }) |
+                    list_views::Take(3);
+        ASSERT(calls == 0u);
+        const std::vector<int> squares(view.begin(), view.end());
+        ASSERT((squares == std::vector<int>{4, 16, 36}));
+        ASSERT(calls == 6u);
+        ASSERT((list == IntList{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+
+        // Filter возвращает ссылки на элементы списка
+        for (int &value : list_views::Filter(list, [](int value) { return value > 8; })) {
+            value = 0;
+        }
+        ASSERT((list == IntList{1, 2, 3, 4, 5, 6, 7, 8, 0, 0}));
+
+        auto empty = list_views::Take(list, 0);
+        ASSERT(empty.begin() == empty.end());
+        auto all = list_views::Take(list, 100);
+        ASSERT(std::distance(all.begin(), all.end()) == 10);
+    }
+
+    // Zip останавливается на более коротком диапазоне
+    {
+        const IntList numbers{1, 2, 3, 4};
+        const std::vector<std::string> names{"one"s, "two"s, "three"s};
+        std::vector<std::string> joined;
+        for (const auto [number, name] : numbers | list_views::Zip(names)) {
+            joined.push_back(std::to_string(number) + name);
+        }
+        ASSERT((joined == std::vector<std::string>{"1one"s, "2two"s, "3three"s}));
+
+        const auto sums = list_views::Zip(numbers, IntList{10, 20, 30, 40, 50}) |
+                          list_views::Transform([](const auto &pair) {
+                              return pair.first + pair.second;
+                          }) |
+                          list_views::Collect(std::allocator<char>());
+        ASSERT((sums == IntList{11, 22, 33, 44}));
+    }
+
+    // Collect по умолчанию размещает узлы в арене списка за один обход
+    // представления: каждая функция стадии вызывается один раз на элемент
+    {
+        using PoolIntList = SingleLinkedList<int, NodePoolAllocator<int>>;
+        const std::vector<int> source{5, 3, 8, 1, 9, 2};
+        int predicate_calls = 0;
+        const auto list = source | list_views::Filter([&predicate_calls](int value) {
+                              ++predicate_calls;
+                              return value > 2;
+                          }) |
+                          list_views::Collect();
+        ASSERT((list == PoolIntList{5, 3, 8, 9}));
+        ASSERT(predicate_calls == 6);
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 1u);
+
+        int transform_calls = 0;
+        const auto strings = list | list_views::Transform([&transform_calls](int value) {
+                                 ++transform_calls;
+                                 return std::to_string(value);
+                             }) |
+                             list_views::Collect();
+        ASSERT((strings == SingleLinkedList<std::string, NodePoolAllocator<std::string>>{
+                               "5"s, "3"s, "8"s, "9"s}));
+        ASSERT(transform_calls == 4);
+
+        // Контейнер без стадий копируется в один блок арены
+        const auto copied = source | list_views::Collect();
+        ASSERT(std::equal(copied.begin(), copied.end(), source.begin(), source.end()));
+        ASSERT(copied.GetAllocator().GetPool().GetBlockCount() == 1u);
+
+        const auto plain = list | list_views::Take(2) | list_views::Collect(std::allocator<char>());
+        ASSERT((plain == IntList{5, 3}));
+
+        const auto nothing = IntList{} | list_views::Take(5) | list_views::Collect();
+        ASSERT(nothing.IsEmpty());
+    }
+}
+
+struct IntrusiveTask {
+    IntrusiveTask() = default;
+    explicit IntrusiveTask(int task_id) : id(task_id) {}
+
+    int id = 0;
+    IntrusiveListHook<IntrusiveTask> queue_hook;
+    IntrusiveListHook<IntrusiveTask> all_hook;
+
+    bool operator==(const IntrusiveTask &rhs) const { return id == rhs.id; }
+    bool operator<(const IntrusiveTask &rhs) const { return id < rhs.id; }
+};
+
+void Test23_IntrusiveList() {
+    using Queue = IntrusiveSingleLinkedList<IntrusiveTask, &IntrusiveTask::queue_hook>;
+    using All = IntrusiveSingleLinkedList<IntrusiveTask, &IntrusiveTask::all_hook>;
+
+    // Список связывает сами объекты, не копируя их
+    {
+        std::vector<IntrusiveTask> pool(5);
+        for (int i = 0; i < 5; ++i) {
+            pool[i].id = i;
+        }
+        Queue queue;
+        ASSERT(queue.IsEmpty());
+        for (auto &task : pool) {
+            queue.PushFront(task);
+        }
+        ASSERT(queue.GetSize() == 5u);
+        ASSERT(&queue.Front() == &pool[4]);
+        // Последний объект тоже считается связанным, хотя за ним никого нет
+        ASSERT(pool[0].queue_hook.next_ == nullptr && pool[0].queue_hook.IsLinked());
+        int expected = 4;
+        for (const IntrusiveTask &task : queue) {
+            ASSERT(&task == &pool[expected]);
+            --expected;
+        }
+
+        IntrusiveTask &popped = queue.PopFront();
+        ASSERT(&popped == &pool[4]);
+        ASSERT(!popped.queue_hook.IsLinked());
+
+        // Вставка и удаление после позиции
+        auto it = queue.InsertAfter(queue.begin(), pool[4]);
+        ASSERT(&*it == &pool[4]);
+        ASSERT(std::next(queue.begin())->id == 4);
+        it = queue.EraseAfter(queue.begin());
+        ASSERT(it->id == 2);
+        ASSERT(queue.GetSize() == 4u);
+        ASSERT(!pool[4].queue_hook.IsLinked());
+
+        // Объект может одновременно состоять в списках с разными связями
+        All all;
+        for (auto &task : pool) {
+            all.PushFront(task);
+        }
+        ASSERT(all.GetSize() == 5u);
+        ASSERT(all.Front().id == 4);
+        ASSERT(queue.Front().id == 3);
+
+        // Копия объекта не наследует его связь
+        const IntrusiveTask copy = pool[2];
+        ASSERT(!copy.queue_hook.IsLinked());
+
+        queue.Clear();
+        ASSERT(queue.IsEmpty());
+        ASSERT(std::all_of(pool.begin(), pool.end(), [](const IntrusiveTask &task) {
+            return !task.queue_hook.IsLinked();
+        }));
+        ASSERT(all.GetSize() == 5u);
+        all.Clear();
+    }
+
+    // Перемещение, обмен и сравнения
+    {
+        IntrusiveTask a(1), b(2), c(1), d(3);
+        Queue first;
+        first.PushFront(b);
+        first.PushFront(a);
+        Queue second;
+        second.PushFront(c);
+        ASSERT(second < first);
+        second.InsertAfter(second.begin(), d);
+        ASSERT(second > first);
+        ASSERT(first != second);
+
+        Queue moved = std::move(first);
+        ASSERT(first.IsEmpty());
+        ASSERT(moved.GetSize() == 2u);
+        swap(moved, second);
+        ASSERT(moved.Front().id == 1 && std::next(moved.begin())->id == 3);
+        ASSERT(&second.Front() == &a);
+        second = std::move(moved);
+        ASSERT(moved.IsEmpty());
+        ASSERT(!a.queue_hook.IsLinked() && !b.queue_hook.IsLinked());
+        ASSERT(&second.Front() == &c);
+    }
+}
+
+void Test24_MpscQueue() {
+    // Однопоточная семантика FIFO
+    {
+        MpscSingleLinkedList<std::string> queue;
+        ASSERT(queue.IsEmpty());
+        ASSERT(!queue.TryPop().has_value());
+        ASSERT(queue.PopBatch(10).IsEmpty());
+        queue.Push("one"s);
+        queue.Emplace(3, 'x');
+        queue.Push("three"s);
+        ASSERT(!queue.IsEmpty());
+        ASSERT(queue.TryPop() == "one"s);
+        queue.Push("four"s);
+        const auto batch = queue.PopBatch(2);
+        const std::vector expected{"xxx"s, "three"s};
+        ASSERT(batch.GetSize() == 2u);
+        ASSERT(std::equal(batch.begin(), batch.end(), expected.begin(), expected.end()));
+        auto last = queue.WaitPopBatch(5);
+        ASSERT(last.GetSize() == 1u && *last.begin() == "four"s);
+        *last.begin() += "!"s;
+        ASSERT(*last.begin() == "four!"s);
+        ASSERT(queue.WaitPopBatchFor(5, 1ms).IsEmpty());
+        ASSERT(queue.PopBatch(0).IsEmpty());
+        // Оставшиеся элементы освобождает деструктор
+        queue.Push("five"s);
+    }
+
+    // Порядок элементов каждого производителя сохраняется, ни один не теряется
+    {
+        constexpr int kProducers = 4;
+        constexpr int kPerProducer = 20000;
+        MpscSingleLinkedList<std::pair<int, int>> queue;
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < kProducers; ++producer) {
+            producers.emplace_back([&queue, producer] {
+                for (int i = 0; i < kPerProducer; ++i) {
+                    queue.Emplace(producer, i);
+                    if (i % 5000 == 0) {
+                        std::this_thread::sleep_for(1ms);
+                    }
+                }
+            });
+        }
+        std::vector<int> next(kProducers, 0);
+        size_t received = 0;
+        while (received < size_t{kProducers} * kPerProducer) {
+            for (const auto &[producer, i] : queue.WaitPopBatch(256)) {
+                ASSERT(i == next[producer]);
+                ++next[producer];
+                ++received;
+            }
+        }
+        for (auto &thread : producers) {
+            thread.join();
+        }
+        ASSERT(queue.IsEmpty());
+        ASSERT(std::all_of(next.begin(), next.end(),
+                           [](int count) { return count == kPerProducer; }));
+    }
+
+    // Спящий потребитель просыпается от вставки
+    {
+        MpscSingleLinkedList<int> queue;
+        std::thread producer([&queue] {
+            std::this_thread::sleep_for(20ms);
+            queue.Push(42);
+        });
+        const auto batch = queue.WaitPopBatchFor(8, 10s);
+        producer.join();
+        ASSERT(batch.GetSize() == 1u && *batch.begin() == 42);
+    }
+}
+
+void Test25_DeltaList() {
+    // Совпадает с std::deque при случайных вставках и удалениях с обоих концов
+    {
+        DeltaSingleLinkedList<int64_t, 16> list;
+        std::deque<int64_t> expected;
+        std::mt19937_64 generator(7);
+        const std::vector<int64_t> extremes{std::numeric_limits<int64_t>::min(),
+                                            std::numeric_limits<int64_t>::max(), 0, -1};
+        for (int i = 0; i < 20000; ++i) {
+            const uint64_t action = generator() % 8;
+            const int64_t value = i % 50 == 0
+                                      ? extremes[generator() % extremes.size()]
+                                      : static_cast<int64_t>(generator() % 2001) - 1000;
+            if (action < 3) {
+                list.PushFront(value);
+                expected.push_front(value);
+            } else if (action < 6) {
+                list.PushBack(value);
+                expected.push_back(value);
+            } else if (!expected.empty()) {
+                ASSERT(list.Front() == expected.front());
+                list.PopFront();
+                expected.pop_front();
+            }
+        }
+        ASSERT(list.GetSize() == expected.size());
+        ASSERT(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+        while (!list.IsEmpty()) {
+            list.PopFront();
+        }
+        ASSERT(list.begin() == list.end());
+        ASSERT(list.GetMemoryUsage() == 0u);
+        list.PushBack(5);
+        ASSERT((list == DeltaSingleLinkedList<int64_t, 16>{5}));
+    }
+
+    // Узкие типы и переполнение разностей
+    {
+        const std::vector<uint8_t> bytes{0, 255, 1, 254, 128, 127};
+        const DeltaSingleLinkedList<uint8_t> small(bytes.begin(), bytes.end());
+        ASSERT(std::equal(small.begin(), small.end(), bytes.begin(), bytes.end()));
+        const DeltaSingleLinkedList<int16_t> shorts{-32768, 32767, 0, -1};
+        ASSERT(*std::next(shorts.begin()) == 32767);
+        ASSERT(*std::next(shorts.begin(), 3) == -1);
+    }
+
+    // Близкие идентификаторы занимают в несколько раз меньше памяти
+    {
+        DeltaSingleLinkedList<uint64_t> ids;
+        std::vector<uint64_t> expected;
+        uint64_t id = uint64_t{1} << 40;
+        std::mt19937 generator(3);
+        for (int i = 0; i < 100000; ++i) {
+            id += 1 + generator() % 60;
+            ids.PushBack(id);
+            expected.push_back(id);
+        }
+        ASSERT(std::equal(ids.begin(), ids.end(), expected.begin(), expected.end()));
+        // Узел SingleLinkedList<uint64_t> занимает не меньше 16 байт
+        ASSERT(ids.GetMemoryUsage() * 10 < expected.size() * 16);
+    }
+
+    // Копирование, перемещение, обмен и сравнения
+    {
+        using List = DeltaSingleLinkedList<int>;
+        const List original{1, 2, 3, 4, 5};
+        List copy = original;
+        ASSERT(copy == original);
+        copy.PushBack(6);
+        ASSERT(copy > original);
+        copy.PushFront(0);
+        ASSERT(copy < original);
+        ASSERT((original != List{1, 2, 3}));
+        ASSERT((List{1, 2, 3} <= original));
+
+        List moved = std::move(copy);
+        ASSERT(copy.IsEmpty());
+        ASSERT(moved.GetSize() == 7u);
+        swap(moved, copy);
+        ASSERT(moved.IsEmpty());
+        ASSERT(copy.Front() == 0);
+        moved = copy;
+        ASSERT(moved == copy);
+        const std::vector<int> values(moved.begin(), moved.end());
+        ASSERT((values == std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+    }
+}
+
+void Test26_RcuList() {
+    // Однопоточная семантика
+    {
+        RcuSingleLinkedList<std::string> list;
+        ASSERT(list.Read().IsEmpty());
+        list.PushFront("three"s);
+        list.EmplaceFront(3, 'x');
+        list.PushFront("one"s);
+        ASSERT(list.GetSize() == 3u);
+        {
+            const auto guard = list.Read();
+            ASSERT((std::vector<std::string>(guard.begin(), guard.end()) ==
+                    std::vector<std::string>{"one"s, "xxx"s, "three"s}));
+            list.EraseAfter(guard.begin());
+            // Читатель, стоявший на удалённом узле, продолжает обход
+            ASSERT(*std::next(guard.begin()) == "three"s);
+        }
+        ASSERT(list.GetSize() == 2u);
+        ASSERT(list.GetRetiredCount() == 1u);
+        list.Synchronize();
+        ASSERT(list.GetRetiredCount() == 0u);
+
+        list.PopFront();
+        ASSERT(*list.Read().begin() == "three"s);
+        list.Clear();
+        ASSERT(list.Read().IsEmpty());
+        ASSERT(list.GetSize() == 0u);
+        // Оставшиеся узлы освобождает деструктор
+        list.PushFront("four"s);
+        list.PopFront();
+    }
+
+    // Открытое чтение задерживает освобождение узлов, которые оно могло видеть
+    {
+        RcuSingleLinkedList<int> list;
+        for (int i = 0; i < 200; ++i) {
+            list.PushFront(i);
+        }
+        {
+            const auto reader = list.Read();
+            const auto first = reader.begin();
+            for (int i = 0; i < 200; ++i) {
+                list.PopFront();
+            }
+            ASSERT(list.GetRetiredCount() == 200u);
+            ASSERT(reader.IsEmpty());
+            ASSERT(*first == 199);
+            ASSERT(std::distance(first, reader.end()) == 200);
+        }
+        list.Synchronize();
+        ASSERT(list.GetRetiredCount() == 0u);
+    }
+
+    // Читатели обходят список без блокировок, пока писатель его меняет.
+    // Писатель вставляет возрастающие значения в начало, поэтому любой обход
+    // видит строго убывающую последовательность
+    {
+        RcuSingleLinkedList<int> list;
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        std::atomic<size_t> traversals{0};
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                while (!done.load()) {
+                    const auto guard = list.Read();
+                    int previous = std::numeric_limits<int>::max();
+                    for (const int value : guard) {
+                        ASSERT(value < previous);
+                        previous = value;
+                    }
+                    traversals.fetch_add(1);
+                }
+            });
+        }
+        std::mt19937 generator(11);
+        for (int i = 0; i < 20000; ++i) {
+            list.PushFront(i);
+            if (generator() % 3 == 0) {
+                list.PopFront();
+            } else if (list.GetSize() > 1) {
+                const auto guard = list.Read();
+                auto it = guard.begin();
+                for (unsigned step = generator() % 8; step > 0; --step) {
+                    if (std::next(it) == guard.end() || std::next(it, 2) == guard.end()) {
+                        break;
+                    }
+                    ++it;
+                }
+                list.EraseAfter(it);
+            }
+        }
+        // На быстрой машине писатель может закончить раньше, чем читатели начнут
+        while (traversals.load() == 0) {
+            std::this_thread::yield();
+        }
+        done = true;
+        for (auto &thread : readers) {
+            thread.join();
+        }
+        ASSERT(traversals.load() > 0u);
+        list.Synchronize();
+        ASSERT(list.GetRetiredCount() == 0u);
+    }
+}
+
+// Аллокатор, считающий выделения и освобождения памяти
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator(size_t &allocations, size_t &deallocations) noexcept
+        : allocations_(&allocations), deallocations_(&deallocations) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) noexcept
+        : allocations_(other.allocations_), deallocations_(other.deallocations_) {}
+
+    T *allocate(size_t count) {
+        ++*allocations_;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *ptr, size_t count) noexcept {
+        ++*deallocations_;
+        std::allocator<T>().deallocate(ptr, count);
+    }
+
+    size_t *allocations_;
+    size_t *deallocations_;
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T> &lhs, const CountingAllocator<U> &rhs) {
+    return lhs.allocations_ == rhs.allocations_;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T> &lhs, const CountingAllocator<U> &rhs) {
+    return !(lhs == rhs);
+}
+
+void Test27_ReserveRecycling() {
+    using CountedList = SingleLinkedList<std::string, CountingAllocator<std::string>>;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    const CountingAllocator<std::string> alloc(allocations, deallocations);
+
+    // Вставки в пределах резерва не обращаются к аллокатору
+    {
+        CountedList list(alloc);
+        list.Reserve(8);
+        ASSERT(allocations == 8u);
+        ASSERT(list.GetCapacity() == 8u);
+        for (int i = 0; i < 8; ++i) {
+            list.PushFront(std::to_string(i));
+        }
+        ASSERT(allocations == 8u);
+
+        list.PopFront();
+        list.EraseAfter(list.begin());
+        list.PushFront("x"s);
+        list.InsertAfter(list.begin(), "y"s);
+        list.Clear();
+        ASSERT(list.GetCapacity() == 8u);
+        for (int i = 0; i < 4; ++i) {
+            list.PushBack(std::to_string(i));
+        }
+        list.Assign({"a"s, "b"s, "c"s, "d"s, "e"s, "f"s, "g"s, "h"s});
+        ASSERT(allocations == 8u);
+        ASSERT(deallocations == 0u);
+
+        // Сверх резерва узлы выделяются и освобождаются как обычно
+        list.PushFront("i"s);
+        ASSERT(allocations == 9u);
+        list.Clear();
+        ASSERT(deallocations == 1u);
+        ASSERT(list.GetCapacity() == 8u);
+
+        list.ShrinkToFit();
+        ASSERT(list.GetCapacity() == 0u);
+        ASSERT(deallocations == 9u);
+        list.PushFront("j"s);
+        ASSERT(allocations == 10u);
+    }
+    ASSERT(allocations == deallocations);
+
+    // Копирующее присваивание берёт недостающие узлы из резерва
+    {
+        CountedList list(alloc);
+        list.Reserve(4);
+        const CountedList source({"a"s, "b"s, "c"s}, alloc);
+        const size_t before = allocations;
+        list = source;
+        ASSERT(list == source);
+        ASSERT(allocations == before);
+        ASSERT(list.GetCapacity() == 4u);
+    }
+    ASSERT(allocations == deallocations);
+
+    // Исключение при создании элемента возвращает узел в резерв
+    {
+        int countdown = 0;
+        SingleLinkedList<ThrowOnCopy> list;
+        list.Reserve(2);
+        const ThrowOnCopy thrower(countdown);
+        try {
+            list.PushFront(thrower);
+            ASSERT(false);
+        } catch (const std::bad_alloc &) {
+        }
+        ASSERT(list.IsEmpty());
+        ASSERT(list.GetCapacity() == 2u);
+    }
+
+    // Резерв переходит вместе с узлами при перемещении и обмене
+    {
+        CountedList first(alloc);
+        first.Reserve(4);
+        first.PushFront("a"s);
+        CountedList second(std::move(first));
+        ASSERT(first.GetCapacity() == 0u);
+        ASSERT(second.GetCapacity() == 4u);
+
+        CountedList third(alloc);
+        third.Reserve(2);
+        third.swap(second);
+        ASSERT(second.GetCapacity() == 2u);
+        ASSERT(third.GetCapacity() == 4u);
+
+        second = std::move(third);
+        ASSERT(second.GetCapacity() == 4u);
+        ASSERT(third.GetCapacity() == 0u);
+        const size_t before = allocations;
+        for (int i = 0; i < 3; ++i) {
+            second.PushFront(std::to_string(i));
+        }
+        ASSERT(allocations == before);
+        ASSERT(second.GetSize() == 4u);
+    }
+    ASSERT(allocations == deallocations);
+
+    // Резерв в арене: Clear не освобождает арену, Compact переносит резерв
+    {
+        using PoolList = SingleLinkedList<std::string, NodePoolAllocator<std::string>>;
+        PoolList list;
+        list.Reserve(16);
+        for (int i = 0; i < 4; ++i) {
+            list.PushBack(std::to_string(i));
+        }
+        list.Clear();
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 1u);
+        list.Assign({"a"s, "b"s, "c"s, "d"s});
+
+        list.Compact();
+        ASSERT((list == PoolList{"a"s, "b"s, "c"s, "d"s}));
+        ASSERT(list.GetCapacity() == 16u);
+        const size_t blocks = list.GetAllocator().GetPool().GetBlockCount();
+        for (int i = 0; i < 12; ++i) {
+            list.PushFront(std::to_string(i));
+        }
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == blocks);
+        ASSERT(list.GetSize() == 16u);
+
+        list.ShrinkToFit();
+        list.Clear();
+        ASSERT(list.GetAllocator().GetPool().GetBlockCount() == 0u);
+    }
+}
+
 void TestSingleList() {
   RUN_TEST(Test1_ThrowOnCopy);
   RUN_TEST(Test2_DeletionSpy);
   RUN_TEST(Test3_ComparsionOperators);
+  RUN_TEST(Test4_Allocators);
+  RUN_TEST(Test5_MoveSemantics);
+  RUN_TEST(Test6_UnrolledList);
+  RUN_TEST(Test7_SortMergeUnique);
+  RUN_TEST(Test8_BulkConstruction);
+  RUN_TEST(Test9_ConcurrentStack);
+  RUN_TEST(Test10_Instrumentation);
+  RUN_TEST(Test11_PrefetchKernels);
+  RUN_TEST(Test12_DeferredDestruction);
+  RUN_TEST(Test13_CompactList);
+  RUN_TEST(Test14_TailAndSplice);
+  RUN_TEST(Test15_SmallList);
+  RUN_TEST(Test16_Compact);
+  RUN_TEST(Test17_MappedList);
+  RUN_TEST(Test18_PersistentList);
+  RUN_TEST(Test19_ParallelAlgorithms);
+  RUN_TEST(Test20_PositionalIndex);
+  RUN_TEST(Test21_SortedList);
+  RUN_TEST(Test22_LazyViews);
+  RUN_TEST(Test23_IntrusiveList);
+  RUN_TEST(Test24_MpscQueue);
+  RUN_TEST(Test25_DeltaList);
+  RUN_TEST(Test26_RcuList);
+  RUN_TEST(Test27_ReserveRecycling);
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Пул потоков фиксированного размера для параллельных алгоритмов списков.
+// Задачи нельзя ставить в ожидание других задач того же пула изнутри рабочего потока
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t thread_count = DefaultThreadCount()) {
+    thread_count = std::max<size_t>(thread_count, 1);
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+      workers_.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Дожидается выполнения всех поставленных задач
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    has_tasks_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  template <typename Task>
+  [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Task>>> Submit(
+      Task&& task) {
+    using Result = std::invoke_result_t<std::decay_t<Task>>;
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Task>(task));
+    auto result = packaged->get_future();
+    {
+      std::lock_guard lock(mutex_);
+      tasks_.emplace_back([packaged] { (*packaged)(); });
+    }
+    has_tasks_.notify_one();
+    return result;
+  }
+
+  [[nodiscard]] size_t GetThreadCount() const noexcept {
+    return workers_.size();
+  }
+
+  [[nodiscard]] static size_t DefaultThreadCount() noexcept {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+ private:
+  void WorkerLoop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock lock(mutex_);
+        has_tasks_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable has_tasks_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+};
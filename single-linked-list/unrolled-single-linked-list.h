@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Развёрнутый односвязный список: каждый узел хранит до N элементов подряд,
+// поэтому обход выполняет одну зависимую загрузку указателя на N элементов.
+// Заполненным не до конца может быть только первый узел
+template <typename Type, size_t N = 16>
+class UnrolledSingleLinkedList {
+  static_assert(N > 0, "Chunk capacity must be positive");
+
+  struct Chunk {
+    Chunk *next_chunk_ = nullptr;
+    // Элементы занимают слоты [first_, N)
+    size_t first_ = N;
+    alignas(Type) std::byte storage_[N * sizeof(Type)];
+
+    explicit Chunk(Chunk *next) noexcept : next_chunk_(next) {}
+
+    [[nodiscard]] Type *Slot(size_t index) noexcept {
+      return std::launder(reinterpret_cast<Type *>(storage_) + index);
+    }
+
+    [[nodiscard]] bool IsFull() const noexcept { return first_ == 0; }
+  };
+
+  template <typename ValueType>
+  class BasicIterator {
+    friend class UnrolledSingleLinkedList;
+    Chunk *chunk_ = nullptr;
+    size_t index_ = 0;
+    explicit BasicIterator(Chunk *chunk) noexcept
+        : chunk_(chunk), index_(chunk ? chunk->first_ : 0) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType *;
+    using reference = ValueType &;
+
+    BasicIterator() = default;
+
+    BasicIterator &operator=(const BasicIterator &rhs) = default;
+
+    BasicIterator(const BasicIterator<Type> &other) noexcept
+        : chunk_(other.chunk_), index_(other.index_) {}
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<const Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool operator==(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+    }
+
+    [[nodiscard]] bool operator!=(
+        const BasicIterator<Type> &rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+    BasicIterator &operator++() noexcept {
+      assert(chunk_);
+      if (++index_ == N) {
+        chunk_ = chunk_->next_chunk_;
+        index_ = chunk_ ? chunk_->first_ : 0;
+      }
+      return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+      auto copy_(*this);
+      ++(*this);
+      return copy_;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      assert(chunk_);
+      return *chunk_->Slot(index_);
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      assert(chunk_);
+      return chunk_->Slot(index_);
+    }
+  };
+
+ public:
+  using Iterator = BasicIterator<Type>;
+  using ConstIterator = BasicIterator<const Type>;
+
+  static constexpr size_t kChunkCapacity = N;
+
+  UnrolledSingleLinkedList() = default;
+
+  UnrolledSingleLinkedList(std::initializer_list<Type> values) {
+    reassign(values.begin(), values.end());
+  }
+
+  UnrolledSingleLinkedList(const UnrolledSingleLinkedList &other) {
+    reassign(other.begin(), other.end());
+  }
+
+  UnrolledSingleLinkedList(UnrolledSingleLinkedList &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  UnrolledSingleLinkedList &operator=(const UnrolledSingleLinkedList &rhs) {
+    reassign(rhs.begin(), rhs.end());
+    return *this;
+  }
+
+  UnrolledSingleLinkedList &operator=(UnrolledSingleLinkedList &&rhs) noexcept {
+    if (this != &rhs) {
+      Clear();
+      head_ = std::exchange(rhs.head_, nullptr);
+      size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+  }
+
+  ~UnrolledSingleLinkedList() { Clear(); }
+
+  // Обменивает содержимое списков за время O(1)
+  void swap(UnrolledSingleLinkedList &other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  [[nodiscard]] Iterator begin() noexcept { return Iterator(head_); }
+
+  [[nodiscard]] Iterator end() noexcept { return Iterator(nullptr); }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {
+    return ConstIterator(head_);
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {
+    return ConstIterator(nullptr);
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] ConstIterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_t GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  void PushFront(const Type &value) { EmplaceFront(value); }
+
+  void PushFront(Type &&value) { EmplaceFront(std::move(value)); }
+
+  template <typename... Args>
+  Type &EmplaceFront(Args &&...args) {
+    if (head_ != nullptr && !head_->IsFull()) {
+      Type *slot = head_->Slot(head_->first_ - 1);
+      ::new (static_cast<void *>(slot)) Type(std::forward<Args>(args)...);
+      --head_->first_;
+      ++size_;
+      return *slot;
+    }
+    auto *chunk = new Chunk(head_);
+    try {
+      ::new (static_cast<void *>(chunk->Slot(N - 1)))
+          Type(std::forward<Args>(args)...);
+    } catch (...) {
+      delete chunk;
+      throw;
+    }
+    chunk->first_ = N - 1;
+    head_ = chunk;
+    ++size_;
+    return *chunk->Slot(N - 1);
+  }
+
+  void Clear() noexcept {
+    while (head_ != nullptr) {
+      Chunk *next = head_->next_chunk_;
+      if constexpr (!std::is_trivially_destructible_v<Type>) {
+        for (size_t i = head_->first_; i < N; ++i) {
+          head_->Slot(i)->~Type();
+        }
+      }
+      delete head_;
+      head_ = next;
+    }
+    size_ = 0;
+  }
+
+ private:
+  // Строит список с тем же порядком элементов: первый узел получает остаток
+  // от деления на N, остальные заполняются полностью
+  template <typename I>
+  void reassign(I begin_, I end_) {
+    UnrolledSingleLinkedList temp_;
+    const auto count = static_cast<size_t>(std::distance(begin_, end_));
+    Chunk **link = &temp_.head_;
+    size_t chunk_size = count % N == 0 ? N : count % N;
+    for (size_t left = count; left > 0; left -= chunk_size, chunk_size = N) {
+      auto *chunk = new Chunk(nullptr);
+      *link = chunk;
+      link = &chunk->next_chunk_;
+      const size_t first = N - chunk_size;
+      size_t i = first;
+      try {
+        for (; i < N; ++i, ++begin_) {
+          ::new (static_cast<void *>(chunk->Slot(i))) Type(*begin_);
+        }
+      } catch (...) {
+        while (i-- > first) {
+          chunk->Slot(i)->~Type();
+        }
+        throw;
+      }
+      chunk->first_ = first;
+      temp_.size_ += chunk_size;
+    }
+    swap(temp_);
+  }
+
+  Chunk *head_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename Type, size_t N>
+void swap(UnrolledSingleLinkedList<Type, N> &lhs,
+          UnrolledSingleLinkedList<Type, N> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename Type, size_t N>
+bool operator==(const UnrolledSingleLinkedList<Type, N> &lhs,
+                const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return (lhs.GetSize() == rhs.GetSize() &&
+          std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, size_t N>
+bool operator!=(const UnrolledSingleLinkedList<Type, N> &lhs,
+                const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+bool operator<(const UnrolledSingleLinkedList<Type, N> &lhs,
+               const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename Type, size_t N>
+bool operator<=(const UnrolledSingleLinkedList<Type, N> &lhs,
+                const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+bool operator>(const UnrolledSingleLinkedList<Type, N> &lhs,
+               const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+bool operator>=(const UnrolledSingleLinkedList<Type, N> &lhs,
+                const UnrolledSingleLinkedList<Type, N> &rhs) {
+  return !(lhs < rhs);
+}